@@ -0,0 +1,212 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "BangCommand.h"
+#include <gtest/gtest.h>
+#include <cwctype>
+#include <random>
+#include <string>
+
+namespace
+{
+	bool EqualsNoCase(std::wstring_view a, std::wstring_view b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			if (towlower(a[i]) != towlower(b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// The if/else chain ExecuteBang used before the hash table: fixed
+	// sub-commands must be the whole parameter, the others take arguments
+	ParsedBang ReferenceParse(std::wstring_view args)
+	{
+		ParsedBang bang;
+		const size_t spacePos = args.find(L' ');
+		bang.action = args.substr(0, spacePos);
+		bang.param = args.substr(spacePos != std::wstring_view::npos ? spacePos + 1 : args.size());
+
+		const std::wstring_view param = bang.param;
+		const size_t subPos = param.find(L' ');
+		const std::wstring_view subAction = param.substr(0, subPos);
+		const std::wstring_view subParam = param.substr(subPos != std::wstring_view::npos ? subPos + 1 : param.size());
+
+		auto is = [&](const wchar_t* name) { return EqualsNoCase(bang.action, name); };
+		auto isParam = [&](const wchar_t* name) { return EqualsNoCase(param, name); };
+
+		if (is(L"WebView"))
+		{
+			bang.command = isParam(L"Start") ? BangCommand::WebViewStart :
+				isParam(L"Stop") ? BangCommand::WebViewStop :
+				isParam(L"Restart") ? BangCommand::WebViewRestart : BangCommand::WebViewUnknown;
+		}
+		else if (is(L"Navigate"))
+		{
+			bang.command = isParam(L"Stop") ? BangCommand::NavigateStop :
+				isParam(L"Reload") ? BangCommand::NavigateReload :
+				isParam(L"Back") ? BangCommand::NavigateBack :
+				isParam(L"Forward") ? BangCommand::NavigateForward :
+				isParam(L"Home") ? BangCommand::NavigateHome : BangCommand::NavigateUrl;
+		}
+		else if (is(L"Open"))
+		{
+			bang.command = isParam(L"DevTools") ? BangCommand::OpenDevTools :
+				isParam(L"TaskManager") ? BangCommand::OpenTaskManager : BangCommand::OpenUnknown;
+		}
+		else if (is(L"Execute"))
+		{
+			bang.command = BangCommand::Execute;
+		}
+		else if (is(L"Script"))
+		{
+			if (EqualsNoCase(subAction, L"Register") || EqualsNoCase(subAction, L"Run"))
+			{
+				bang.command = EqualsNoCase(subAction, L"Register") ? BangCommand::ScriptRegister : BangCommand::ScriptRun;
+				bang.param = subParam;
+			}
+			else
+			{
+				bang.command = BangCommand::ScriptUnknown;
+			}
+		}
+		else if (is(L"Batch"))
+		{
+			bang.command = BangCommand::Batch;
+		}
+
+		// Fixed sub-commands consume the parameter
+		switch (bang.command)
+		{
+		case BangCommand::WebViewStart: case BangCommand::WebViewStop: case BangCommand::WebViewRestart:
+		case BangCommand::NavigateStop: case BangCommand::NavigateReload: case BangCommand::NavigateBack:
+		case BangCommand::NavigateForward: case BangCommand::NavigateHome:
+		case BangCommand::OpenDevTools: case BangCommand::OpenTaskManager:
+			bang.param = param.substr(param.size());
+			break;
+		default:
+			break;
+		}
+		return bang;
+	}
+
+	void ExpectSame(const std::wstring& args)
+	{
+		const ParsedBang expected = ReferenceParse(args);
+		const ParsedBang parsed = ParseBang(args);
+		EXPECT_EQ(parsed.command, expected.command) << std::string(args.begin(), args.end());
+		EXPECT_EQ(parsed.action, expected.action);
+		EXPECT_EQ(parsed.param, expected.param) << std::string(args.begin(), args.end());
+
+		// param ends where args ends, so it stays null-terminated
+		EXPECT_EQ(parsed.param.data() + parsed.param.size(), args.data() + args.size());
+	}
+}
+
+TEST(BangCommand, Table)
+{
+	struct Case
+	{
+		const wchar_t* args;
+		BangCommand command;
+		const wchar_t* param;
+	};
+
+	const Case cases[] =
+	{
+		{ L"WebView Start", BangCommand::WebViewStart, L"" },
+		{ L"webview STOP", BangCommand::WebViewStop, L"" },
+		{ L"WebView Restart", BangCommand::WebViewRestart, L"" },
+		{ L"WebView Start now", BangCommand::WebViewUnknown, L"Start now" },
+		{ L"WebView", BangCommand::WebViewUnknown, L"" },
+		{ L"Navigate https://example.com/", BangCommand::NavigateUrl, L"https://example.com/" },
+		{ L"Navigate Home", BangCommand::NavigateHome, L"" },
+		{ L"Navigate home page", BangCommand::NavigateUrl, L"home page" },
+		{ L"Navigate Back", BangCommand::NavigateBack, L"" },
+		{ L"Navigate Forward", BangCommand::NavigateForward, L"" },
+		{ L"Navigate Reload", BangCommand::NavigateReload, L"" },
+		{ L"Navigate Stop", BangCommand::NavigateStop, L"" },
+		{ L"Open DevTools", BangCommand::OpenDevTools, L"" },
+		{ L"Open taskmanager", BangCommand::OpenTaskManager, L"" },
+		{ L"Open Settings", BangCommand::OpenUnknown, L"Settings" },
+		{ L"Execute alert('a b')", BangCommand::Execute, L"alert('a b')" },
+		{ L"Execute #@#script.js", BangCommand::Execute, L"#@#script.js" },
+		{ L"Execute", BangCommand::Execute, L"" },
+		{ L"Script Register clock #@#clock.js", BangCommand::ScriptRegister, L"clock #@#clock.js" },
+		{ L"Script Run clock 'red', 2", BangCommand::ScriptRun, L"clock 'red', 2" },
+		{ L"Script Run", BangCommand::ScriptRun, L"" },
+		{ L"Script Delete clock", BangCommand::ScriptUnknown, L"Delete clock" },
+		{ L"Batch Navigate Home | Execute a()", BangCommand::Batch, L"Navigate Home | Execute a()" },
+		{ L"Unknown Start", BangCommand::Unknown, L"Start" },
+		{ L"", BangCommand::Unknown, L"" },
+		{ L"Navigatex Home", BangCommand::Unknown, L"Home" },
+		{ L"Execut alert()", BangCommand::Unknown, L"alert()" },
+	};
+
+	for (const Case& test : cases)
+	{
+		const std::wstring args = test.args;
+		const ParsedBang parsed = ParseBang(args);
+		EXPECT_EQ(parsed.command, test.command) << std::string(args.begin(), args.end());
+		EXPECT_EQ(parsed.param, test.param) << std::string(args.begin(), args.end());
+		ExpectSame(args);
+	}
+}
+
+TEST(BangCommand, MatchesReferenceParser)
+{
+	static const wchar_t* const words[] =
+	{
+		L"WebView", L"Navigate", L"Open", L"Execute", L"Script", L"Batch", L"Start", L"Stop", L"Restart",
+		L"Reload", L"Back", L"Forward", L"Home", L"DevTools", L"TaskManager", L"Register", L"Run",
+		L"webVIEW", L"HOME", L"x", L"", L"navigat", L"scripts", L"a(1, 2)",
+	};
+
+	std::mt19937 random(3);
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::wstring args;
+		const size_t count = std::uniform_int_distribution<size_t>(1, 4)(random);
+		for (size_t w = 0; w < count; ++w)
+		{
+			if (w > 0) args += L' ';
+			args += words[std::uniform_int_distribution<size_t>(0, std::size(words) - 1)(random)];
+		}
+		ExpectSame(args);
+	}
+}
+
+TEST(BangCommand, AppendAction)
+{
+	struct Case
+	{
+		const wchar_t* bang;
+		const wchar_t* action;
+		const wchar_t* expected;
+	};
+
+	const Case cases[] =
+	{
+		{ L"", L"", L"" },
+		{ L"", L"  \t", L"" },
+		{ L"", L"!Log Loaded", L"[!Log Loaded]" },
+		{ L"", L"  !Redraw", L"[!Redraw]" },
+		{ L"", L"[!A][!B]", L"[!A][!B]" },
+		{ L"", L" [!A] [!B]", L"[!A] [!B]" },
+		{ L"[!A]", L"!B", L"[!A][!B]" },
+		{ L"[!A]", L"[!B][!C]", L"[!A][!B][!C]" },
+		{ L"[!A]", L"notepad.exe", L"[!A][notepad.exe]" },
+	};
+
+	for (const Case& test : cases)
+	{
+		std::wstring bang = test.bang;
+		AppendAction(bang, test.action);
+		EXPECT_EQ(bang, test.expected) << std::string(bang.begin(), bang.end());
+	}
+}
@@ -0,0 +1,364 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+// Benchmarks of the platform independent hot paths. BenchmarksScalar is the
+// same suite built with SI_NO_SIMD and SI_NO_MMAP, for comparing the SSE2
+// scanning and the memory mapped loading against the plain code.
+
+#include "BangCommand.h"
+#include "HeadlessMeasure.h"
+#include "ScriptDecode.h"
+#include "Url.h"
+#include "Ini/SimpleIni.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#include <new>
+
+// Heap use of the whole process, for the peak memory of the load benchmarks
+static size_t g_heapBytes = 0;
+static size_t g_heapPeak = 0;
+
+void* operator new(size_t size)
+{
+	void* p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	g_heapBytes += malloc_usable_size(p);
+	if (g_heapBytes > g_heapPeak) g_heapPeak = g_heapBytes;
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	if (!p) return;
+	g_heapBytes -= malloc_usable_size(p);
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	operator delete(p);
+}
+#endif
+
+namespace
+{
+	// Peak heap growth while it is in scope
+	class HeapPeak
+	{
+	public:
+#ifdef __GLIBC__
+		HeapPeak() : start(g_heapBytes) { g_heapPeak = g_heapBytes; }
+		size_t Bytes() const { return g_heapPeak - start; }
+
+	private:
+		size_t start;
+#else
+		size_t Bytes() const { return 0; }
+#endif
+	};
+
+	// Settings file with the given number of sections of 100 keys each
+	const std::string& LargeIni(size_t sections)
+	{
+		static std::map<size_t, std::string> cache;
+		std::string& text = cache[sections];
+		if (text.empty())
+		{
+			for (size_t s = 0; s < sections; ++s)
+			{
+				text += "[Section" + std::to_string(s) + "]\r\n";
+				for (size_t k = 0; k < 100; ++k)
+				{
+					text += "SettingName" + std::to_string(k) + " = https://example.com/path/" + std::to_string(s * 100 + k) + "?query=value\r\n";
+				}
+				text += "; comment line\r\n\r\n";
+			}
+		}
+		return text;
+	}
+
+	std::string WriteTempFile(const std::string& text)
+	{
+		char path[] = "/tmp/WebView2BenchXXXXXX";
+		const int fd = mkstemp(path);
+		if (fd >= 0)
+		{
+			if (write(fd, text.data(), text.size()) != static_cast<ssize_t>(text.size()))
+				perror("write");
+			close(fd);
+		}
+		return path;
+	}
+}
+
+// String storage, one allocation per string or the arena
+static void BM_SimpleIniSetValues(benchmark::State& state)
+{
+	const bool arena = state.range(0) != 0;
+	std::vector<std::string> names;
+	for (int i = 0; i < 5000; ++i)
+	{
+		names.push_back("Key" + std::to_string(i));
+	}
+
+	for (auto _ : state)
+	{
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		ini.SetArenaStrings(arena);
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			ini.SetValue(i % 2 ? "Odd" : "Even", names[i].c_str(), "some value of a setting");
+		}
+		benchmark::DoNotOptimize(ini.GetSectionSize("Odd"));
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_SimpleIniSetValues)->Arg(0)->Arg(1);
+
+// Loading from memory and from a file, up to about 3 MB. With merge, the file
+// is loaded into an object that already holds data, which copies every string,
+// one by one or into the arena.
+static void BM_SimpleIniLoadData(benchmark::State& state)
+{
+	const std::string& text = LargeIni(static_cast<size_t>(state.range(0)));
+	const int64_t mode = state.range(1);
+	size_t peak = 0;
+	for (auto _ : state)
+	{
+		HeapPeak heap;
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		ini.SetArenaStrings(mode == 2);
+		if (mode != 0) ini.LoadData("[Base]\nKey=Value\n");
+		benchmark::DoNotOptimize(ini.LoadData(text));
+		peak = heap.Bytes();
+	}
+	state.SetBytesProcessed(state.iterations() * text.size());
+	state.counters["peakHeap"] = benchmark::Counter(static_cast<double>(peak), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+BENCHMARK(BM_SimpleIniLoadData)->ArgNames({ "sections", "load/merge/mergeArena" })->ArgsProduct({ { 1, 50, 500 }, { 0, 1, 2 } });
+
+static void BM_SimpleIniLoadFile(benchmark::State& state)
+{
+	const std::string& text = LargeIni(static_cast<size_t>(state.range(0)));
+	const std::string path = WriteTempFile(text);
+	size_t peak = 0;
+	for (auto _ : state)
+	{
+		HeapPeak heap;
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		benchmark::DoNotOptimize(ini.LoadFile(path.c_str()));
+		peak = heap.Bytes();
+	}
+	remove(path.c_str());
+	state.SetBytesProcessed(state.iterations() * text.size());
+	state.counters["peakHeap"] = benchmark::Counter(static_cast<double>(peak), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+BENCHMARK(BM_SimpleIniLoadFile)->ArgName("sections")->Arg(1)->Arg(50)->Arg(500);
+
+// Lookups through the trees, the frozen index and key handles
+static void BM_SimpleIniGetValue(benchmark::State& state)
+{
+	const bool byHandle = state.range(1) != 0;
+	CSimpleIniA ini;
+	ini.SetUnicode();
+	ini.LoadData(LargeIni(20));
+	if (state.range(0)) ini.Freeze();
+
+	std::vector<std::string> sections, keys;
+	for (int i = 0; i < 64; ++i)
+	{
+		sections.push_back("Section" + std::to_string(i * 7 % 20));
+		keys.push_back("SettingName" + std::to_string(i * 13 % 100));
+	}
+	std::vector<CSimpleIniA::KeyHandle> handles;
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		handles.emplace_back(sections[i].c_str(), keys[i].c_str());
+	}
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < sections.size(); ++i)
+		{
+			if (byHandle)
+				benchmark::DoNotOptimize(ini.GetValue(handles[i]));
+			else
+				benchmark::DoNotOptimize(ini.GetValue(sections[i].c_str(), keys[i].c_str()));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * sections.size());
+}
+BENCHMARK(BM_SimpleIniGetValue)->ArgNames({ "frozen", "handle" })->Ranges({ { 0, 1 }, { 0, 1 } });
+
+// Saving after one section changed
+static void BM_SimpleIniSave(benchmark::State& state)
+{
+	CSimpleIniA ini;
+	ini.SetUnicode();
+	ini.SetIncrementalSave(state.range(0) != 0);
+	ini.LoadData(LargeIni(20));
+
+	int counter = 0;
+	for (auto _ : state)
+	{
+		ini.SetValue("Section3", "SettingName5", std::to_string(++counter).c_str());
+		std::string text;
+		ini.Save(text);
+		benchmark::DoNotOptimize(text.data());
+	}
+}
+BENCHMARK(BM_SimpleIniSave)->Arg(0)->Arg(1);
+
+// UTF-8 to UTF-16 transcoding
+static void BM_Utf8ToWide(benchmark::State& state)
+{
+	std::string text;
+	while (text.size() < 64 * 1024)
+	{
+		text += state.range(0) ? "function update() { return \xE2\x82\xAC 42; }\n" : "function update() { return 42; }\n";
+	}
+	std::u16string out(text.size(), u'\0');
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(SI_Utf8ToWide(text.data(), text.size(), &out[0], out.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf8ToWide)->ArgName("nonAscii")->Arg(0)->Arg(1);
+
+// Decoding a bundled script of 1 to 10 MB as UTF-8, UTF-16 LE or UTF-16 BE
+static void BM_DecodeScript(benchmark::State& state)
+{
+	static const char* const boms[] = { "\xEF\xBB\xBF", "\xFF\xFE", "\xFE\xFF" };
+	const int64_t encoding = state.range(1);
+	const size_t size = static_cast<size_t>(state.range(0)) * 1024 * 1024;
+
+	std::string utf8;
+	while (utf8.size() < (encoding ? size / 2 : size))
+	{
+		utf8 += "function update() { return \"\xE2\x82\xAC\" + 42; }\n";
+	}
+
+	std::string bytes = boms[encoding];
+	if (encoding == 0)
+	{
+		bytes += utf8;
+	}
+	else
+	{
+		std::u16string text(utf8.size(), u'\0');
+		text.resize(SI_Utf8ToWide(utf8.data(), utf8.size(), &text[0], text.size()));
+		for (char16_t ch : text)
+		{
+			const char low = static_cast<char>(ch & 0xFF), high = static_cast<char>(ch >> 8);
+			bytes += encoding == 1 ? low : high;
+			bytes += encoding == 1 ? high : low;
+		}
+	}
+
+	std::u16string out;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(DecodeScriptBytes(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), out));
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_DecodeScript)->ArgNames({ "MB", "utf8/le/be" })->ArgsProduct({ { 1, 10 }, { 0, 1, 2 } });
+
+// Origin of a navigation
+static void BM_NormalizeUri(benchmark::State& state)
+{
+	static const wchar_t* const urls[] =
+	{
+		L"https://www.example.com/articles/2025/10/some-article-title?utm_source=feed&utm_medium=rss#comments",
+		L"file:///C:/Users/User/Documents/Rainmeter/Skins/WebView2/index.html",
+		L"https://cdn.example.net/assets/app.js",
+		L"view-source:https://example.org/",
+		L"about:blank",
+	};
+
+	std::wstring origin;
+	for (auto _ : state)
+	{
+		for (const wchar_t* url : urls)
+		{
+			NormalizeUri(std::wstring_view(url), origin);
+			benchmark::DoNotOptimize(origin.data());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * std::size(urls));
+}
+BENCHMARK(BM_NormalizeUri);
+
+// Bang dispatch
+static void BM_ParseBang(benchmark::State& state)
+{
+	static const wchar_t* const bangs[] =
+	{
+		L"Navigate Home", L"Execute document.title", L"WebView Restart", L"Script Run clock 'red', 2",
+		L"Open DevTools", L"Navigate https://example.com/",
+	};
+
+	for (auto _ : state)
+	{
+		for (const wchar_t* bang : bangs)
+		{
+			benchmark::DoNotOptimize(ParseBang(bang).command);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * std::size(bangs));
+}
+BENCHMARK(BM_ParseBang);
+
+// One skin update of the headless driver for 1 to 100 measures, each
+// reloading with DynamicVariables=1 and flushing the actions of a navigation
+// every fourth update
+static void BM_HeadlessTick(benchmark::State& state)
+{
+	FakeSkin skin;
+	std::vector<std::unique_ptr<HeadlessMeasure>> measures;
+	for (int64_t i = 0; i < state.range(0); ++i)
+	{
+		measures.push_back(std::make_unique<HeadlessMeasure>(&skin));
+		FakeMeasure& rm = measures.back()->rm;
+		rm.options[L"Url"] = L"https://example.com/";
+		rm.options[L"OnStateChangeAction"] = L"!UpdateMeter State";
+		rm.options[L"OnPageLoadFinishAction"] = L"[!UpdateMeasure Title][!Redraw]";
+		measures.back()->Reload();
+	}
+
+	size_t tick = 0, reads = 0;
+	for (auto _ : state)
+	{
+		skin.executed.clear();
+		const bool navigated = (++tick % 4) == 0;
+		for (auto& measure : measures)
+		{
+			measure->rm.stringReads = 0;
+			measure->Reload();
+			if (navigated)
+			{
+				for (MeasureEvent event : g_coalescedEventOrder)
+				{
+					measure->NotifyAction(event);
+				}
+			}
+			measure->FlushActions();
+			reads += measure->rm.stringReads;
+		}
+	}
+	state.counters["reads/measure"] = benchmark::Counter(static_cast<double>(reads) / (state.iterations() * measures.size()));
+}
+BENCHMARK(BM_HeadlessTick)->Arg(1)->Arg(10)->Arg(100);
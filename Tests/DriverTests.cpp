@@ -0,0 +1,203 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "HeadlessMeasure.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const wchar_t* const kOptionNames[] =
+	{
+		L"W", L"H", L"X", L"Y", L"Clickthrough", L"ZoomFactor", L"Hidden", L"Notifications", L"NewWindow",
+		L"ZoomControl", L"AssistiveFeatures", L"HostSecurity", L"HostOrigin", L"HostPath", L"UserAgent",
+		L"BatchDelimiter", L"BatchMergeExecute", L"CoalesceActions", L"Url", L"OnWebViewLoadAction",
+		L"OnWebViewFailAction", L"OnWebViewStopAction", L"OnStateChangeAction", L"OnUrlChangeAction",
+		L"OnPageLoadStartAction", L"OnPageLoadingAction", L"OnPageDOMLoadAction", L"OnPageLoadFinishAction",
+		L"OnPageFirstLoadAction", L"OnPageReloadAction",
+	};
+	static_assert(std::size(kOptionNames) == static_cast<size_t>(ReloadOption::Count), "Every option is listed");
+
+	void SetTypicalOptions(FakeMeasure& rm)
+	{
+		rm.options[L"Url"] = L"https://example.com/";
+		rm.options[L"W"] = L"400";
+		rm.options[L"ZoomFactor"] = L"1.5";
+		rm.options[L"OnStateChangeAction"] = L"!UpdateMeter State";
+		rm.options[L"OnUrlChangeAction"] = L"[!SetVariable Url \"[WebView2]\"][!UpdateMeter *]";
+		rm.options[L"OnPageLoadFinishAction"] = L"!Redraw";
+	}
+}
+
+TEST(Driver, UnchangedOptionsOnlyReadTheFingerprint)
+{
+	FakeSkin skin;
+	HeadlessMeasure measure(&skin);
+	SetTypicalOptions(measure.rm);
+
+	measure.Reload();
+	EXPECT_EQ(measure.fullReloads, 1u);
+	EXPECT_EQ(measure.width, 400);
+	EXPECT_EQ(measure.zoomFactor, 1.5);
+	EXPECT_EQ(measure.url, L"https://example.com/");
+
+	for (int i = 0; i < 10; ++i)
+	{
+		measure.rm.stringReads = 0;
+		measure.rm.formulaReads = 0;
+		measure.Reload();
+
+		// One raw read per option and no formula evaluation
+		EXPECT_EQ(measure.rm.stringReads, static_cast<size_t>(ReloadOption::Count));
+		EXPECT_EQ(measure.rm.formulaReads, 0u);
+	}
+	EXPECT_EQ(measure.fullReloads, 1u);
+	EXPECT_EQ(measure.fastReloads, 10u);
+}
+
+TEST(Driver, AnyChangedOptionReloadsFully)
+{
+	FakeSkin skin;
+	HeadlessMeasure measure(&skin);
+	SetTypicalOptions(measure.rm);
+	measure.Reload();
+
+	size_t expected = 1;
+	for (const wchar_t* name : kOptionNames)
+	{
+		const std::wstring before = measure.rm.options[name];
+		measure.rm.options[name] = before + L"1";
+		measure.Reload();
+		EXPECT_EQ(measure.fullReloads, ++expected) << std::string(name, name + wcslen(name));
+
+		// And back again
+		measure.rm.options[name] = before;
+		measure.Reload();
+		EXPECT_EQ(measure.fullReloads, ++expected);
+	}
+
+	// Text moved from one option to the next is a change too
+	measure.rm.options[L"HostPath"] = L"ab";
+	measure.rm.options[L"UserAgent"] = L"";
+	measure.Reload();
+	measure.rm.options[L"HostPath"] = L"a";
+	measure.rm.options[L"UserAgent"] = L"b";
+	measure.Reload();
+	EXPECT_EQ(measure.fullReloads, expected + 2);
+}
+
+TEST(Driver, MissingOptionsUseDefaults)
+{
+	FakeSkin skin;
+	FakeMeasure rm(&skin);
+	EXPECT_EQ(ReadOptionInt(&rm, ReloadOption::W), 800);
+	EXPECT_EQ(ReadOptionInt(&rm, ReloadOption::H), 600);
+	EXPECT_EQ(ReadOptionInt(&rm, ReloadOption::Clickthrough), 2);
+	EXPECT_EQ(ReadOptionFormula(&rm, ReloadOption::ZoomFactor), 1.0);
+	EXPECT_EQ(ReadOptionInt(&rm, ReloadOption::ZoomControl), 1);
+	EXPECT_EQ(ReadOptionString(&rm, ReloadOption::BatchDelimiter), L"|");
+	EXPECT_EQ(ReadOptionString(&rm, ReloadOption::Url), L"");
+
+	// An empty option hashes like a missing one
+	const unsigned long long missing = GetOptionsFingerprint(&rm);
+	rm.options[L"UserAgent"] = L"";
+	EXPECT_EQ(GetOptionsFingerprint(&rm), missing);
+}
+
+TEST(Driver, CoalescedActionsRunAsOneBang)
+{
+	FakeSkin skin;
+	HeadlessMeasure measure(&skin);
+	SetTypicalOptions(measure.rm);
+	measure.Reload();
+
+	// Nothing queued, nothing executed
+	measure.FlushActions();
+	EXPECT_TRUE(skin.executed.empty());
+
+	// A whole navigation between two updates, events repeating and out of order
+	const MeasureEvent events[] =
+	{
+		EVENT_STATE_CHANGE, EVENT_PAGE_LOAD_START, EVENT_STATE_CHANGE, EVENT_URL_CHANGE, EVENT_PAGE_LOADING,
+		EVENT_STATE_CHANGE, EVENT_PAGE_DOM_LOAD, EVENT_PAGE_LOAD_FINISH, EVENT_STATE_CHANGE, EVENT_URL_CHANGE,
+	};
+	for (MeasureEvent event : events)
+	{
+		measure.NotifyAction(event);
+	}
+	measure.FlushActions();
+
+	ASSERT_EQ(skin.executed.size(), 1u);
+	EXPECT_EQ(skin.executed[0], L"[!SetVariable Url \"[WebView2]\"][!UpdateMeter *][!Redraw][!UpdateMeter State]");
+	EXPECT_EQ(measure.deliveredEvents, static_cast<unsigned int>(EVENT_STATE_CHANGE | EVENT_URL_CHANGE |
+		EVENT_PAGE_LOAD_START | EVENT_PAGE_LOADING | EVENT_PAGE_DOM_LOAD | EVENT_PAGE_LOAD_FINISH));
+
+	// Delivered once
+	measure.FlushActions();
+	EXPECT_EQ(skin.executed.size(), 1u);
+
+	// Events without actions execute nothing, but are still delivered
+	measure.NotifyAction(EVENT_PAGE_RELOAD);
+	measure.FlushActions();
+	EXPECT_EQ(skin.executed.size(), 1u);
+	EXPECT_EQ(measure.deliveredEvents, static_cast<unsigned int>(EVENT_PAGE_RELOAD));
+}
+
+TEST(Driver, BangDispatch)
+{
+	FakeSkin skin;
+	HeadlessMeasure measure(&skin);
+	EXPECT_EQ(measure.ExecuteBang(L"Navigate https://example.com/"), BangCommand::NavigateUrl);
+	EXPECT_EQ(measure.ExecuteBang(L"navigate home"), BangCommand::NavigateHome);
+	EXPECT_EQ(measure.ExecuteBang(L"Script Run clock"), BangCommand::ScriptRun);
+	EXPECT_EQ(measure.ExecuteBang(L"Batch Navigate Home | Execute a()"), BangCommand::Batch);
+	EXPECT_EQ(measure.ExecuteBang(L"Refresh"), BangCommand::Unknown);
+}
+
+// Per tick, a skin of many measures costs one RmReadString per option and
+// measure, and at most one RmExecute per measure that had events
+TEST(Driver, CallsPerTick)
+{
+	FakeSkin skin;
+	std::vector<std::unique_ptr<HeadlessMeasure>> measures;
+	for (int i = 0; i < 100; ++i)
+	{
+		measures.push_back(std::make_unique<HeadlessMeasure>(&skin));
+		SetTypicalOptions(measures.back()->rm);
+		measures.back()->Reload();
+	}
+
+	std::mt19937 random(4);
+	for (int tick = 0; tick < 50; ++tick)
+	{
+		skin.executed.clear();
+		size_t notified = 0;
+		for (auto& measure : measures)
+		{
+			measure->rm.stringReads = 0;
+			measure->Reload();
+			EXPECT_EQ(measure->rm.stringReads, static_cast<size_t>(ReloadOption::Count));
+
+			if (random() % 4 == 0)
+			{
+				for (int i = 0; i < 5; ++i)
+				{
+					measure->NotifyAction(g_coalescedEventOrder[random() % std::size(g_coalescedEventOrder)]);
+				}
+				++notified;
+			}
+			measure->FlushActions();
+		}
+		EXPECT_LE(skin.executed.size(), notified);
+	}
+
+	for (auto& measure : measures)
+	{
+		EXPECT_EQ(measure->fullReloads, 1u);
+		EXPECT_EQ(measure->fastReloads, 50u);
+	}
+}
@@ -0,0 +1,103 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "FakeRainmeter.h"
+#include <Windows.h>
+#include "../API/RainmeterAPI.h"
+#include <cstdarg>
+#include <cwchar>
+#include <cwctype>
+
+bool FakeMeasure::NoCaseLess::operator()(const std::wstring& a, const std::wstring& b) const
+{
+	const size_t size = a.size() < b.size() ? a.size() : b.size();
+	for (size_t i = 0; i < size; ++i)
+	{
+		const wint_t left = towlower(a[i]);
+		const wint_t right = towlower(b[i]);
+		if (left != right)
+			return left < right;
+	}
+	return a.size() < b.size();
+}
+
+namespace
+{
+	FakeMeasure* ToMeasure(void* rm)
+	{
+		return static_cast<FakeMeasure*>(rm);
+	}
+
+	// Missing and empty options read as the default, as in Rainmeter
+	const std::wstring* FindOption(FakeMeasure* measure, LPCWSTR option)
+	{
+		const auto it = measure->options.find(option);
+		return (it != measure->options.end() && !it->second.empty()) ? &it->second : nullptr;
+	}
+}
+
+LPCWSTR __stdcall RmReadString(void* rm, LPCWSTR option, LPCWSTR defValue, BOOL /*replaceMeasures*/)
+{
+	FakeMeasure* measure = ToMeasure(rm);
+	++measure->stringReads;
+
+	const std::wstring* value = FindOption(measure, option);
+	measure->readBuffer = value ? *value : defValue;
+	return measure->readBuffer.c_str();
+}
+
+// Plain numbers only, formulas are not evaluated
+double __stdcall RmReadFormula(void* rm, LPCWSTR option, double defValue)
+{
+	FakeMeasure* measure = ToMeasure(rm);
+	++measure->formulaReads;
+
+	const std::wstring* value = FindOption(measure, option);
+	if (!value)
+		return defValue;
+
+	wchar_t* end = nullptr;
+	const double number = wcstod(value->c_str(), &end);
+	return (end && *end == L'\0') ? number : defValue;
+}
+
+LPCWSTR __stdcall RmReplaceVariables(void* /*rm*/, LPCWSTR str)
+{
+	return str;
+}
+
+LPCWSTR __stdcall RmPathToAbsolute(void* /*rm*/, LPCWSTR relativePath)
+{
+	return relativePath;
+}
+
+void __stdcall RmExecute(void* skin, LPCWSTR command)
+{
+	static_cast<FakeSkin*>(skin)->executed.push_back(command);
+}
+
+void* __stdcall RmGet(void* rm, int type)
+{
+	return type == RMG_SKIN ? ToMeasure(rm)->skin : nullptr;
+}
+
+void __stdcall RmLog(void* rm, int /*level*/, LPCWSTR message)
+{
+	ToMeasure(rm)->log.push_back(message);
+}
+
+void __cdecl RmLogF(void* rm, int level, LPCWSTR format, ...)
+{
+	wchar_t buffer[1024];
+	va_list args;
+	va_start(args, format);
+	vswprintf(buffer, sizeof(buffer) / sizeof(buffer[0]), format, args);
+	va_end(args);
+	RmLog(rm, level, buffer);
+}
+
+BOOL __cdecl LSLog(int /*level*/, LPCWSTR /*unused*/, LPCWSTR /*message*/)
+{
+	return TRUE;
+}
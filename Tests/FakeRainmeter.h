@@ -0,0 +1,39 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+// In-process stand-in for the Rainmeter API, so the plugin sources that read
+// options and execute bangs run without Rainmeter. The rm pointer handed to
+// the plugin is a FakeMeasure, and the skin pointer is a FakeSkin.
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct FakeSkin
+{
+	std::vector<std::wstring> executed; // Every RmExecute command, in order
+};
+
+struct FakeMeasure
+{
+	struct NoCaseLess
+	{
+		bool operator()(const std::wstring& a, const std::wstring& b) const;
+	};
+
+	explicit FakeMeasure(FakeSkin* skin) : skin(skin) {}
+
+	FakeSkin* skin;
+	std::map<std::wstring, std::wstring, NoCaseLess> options;
+	std::vector<std::wstring> log;
+
+	// Calls made by the plugin
+	size_t stringReads = 0;
+	size_t formulaReads = 0;
+
+	// Like Rainmeter, RmReadString returns a buffer that the next read replaces
+	std::wstring readBuffer;
+};
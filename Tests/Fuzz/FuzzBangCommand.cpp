@@ -0,0 +1,24 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "BangCommand.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	const std::wstring args(data, data + size);
+	const ParsedBang bang = ParseBang(args);
+
+	// Both views stay inside args, and param ends where args ends
+	const wchar_t* begin = args.data();
+	const wchar_t* end = args.data() + args.size();
+	if (bang.action.data() < begin || bang.action.data() + bang.action.size() > end ||
+		bang.param.data() + bang.param.size() != end)
+	{
+		abort();
+	}
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+// Runs a fuzz target over the files given on the command line, or the files
+// in the given directories, for builds without libFuzzer
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static void RunFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	LLVMFuzzerTestOneInput(data.data(), data.size());
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::filesystem::path path = argv[i];
+		if (std::filesystem::is_directory(path))
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(path))
+			{
+				RunFile(entry.path());
+				++count;
+			}
+		}
+		else
+		{
+			RunFile(path);
+			++count;
+		}
+	}
+
+	// Every target has to cope with no input at all
+	LLVMFuzzerTestOneInput(nullptr, 0);
+	printf("Ran %zu inputs\n", count);
+	return 0;
+}
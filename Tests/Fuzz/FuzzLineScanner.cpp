@@ -0,0 +1,62 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+// SI_LineScanner, vectorized where SSE2 is available, against a plain loop,
+// from every start offset and alignment of the input
+
+#include "Ini/SimpleIni.h"
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	template<class Char>
+	const Char* ScalarFind(const Char* data, Char delim)
+	{
+		while (*data && *data != delim && *data != '\n' && *data != '\r')
+		{
+			++data;
+		}
+		return data;
+	}
+
+	template<class Char>
+	void Compare(const uint8_t* data, size_t size)
+	{
+		// Aligned like the buffers SimpleIni allocates, with room for a whole
+		// block after the terminating NULL
+		const size_t count = size / sizeof(Char);
+		std::vector<Char> buffer(count + 1 + 32, Char());
+		for (size_t i = 0; i < count; ++i)
+		{
+			uint32_t ch = 0;
+			for (size_t b = 0; b < sizeof(Char); ++b)
+			{
+				ch |= static_cast<uint32_t>(data[i * sizeof(Char) + b]) << (8 * b);
+			}
+			buffer[i] = static_cast<Char>(ch);
+		}
+
+		const Char delims[] = { Char(), Char('='), Char(']'), count ? buffer[0] : Char('x') };
+		for (size_t start = 0; start <= count; ++start)
+		{
+			for (Char delim : delims)
+			{
+				if (SI_LineScanner<Char>::Find(&buffer[start], delim) != ScalarFind(&buffer[start], delim))
+					abort();
+			}
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	if (size > 4096)
+		return 0;
+
+	Compare<char>(data, size);
+	Compare<char16_t>(data, size);
+	return 0;
+}
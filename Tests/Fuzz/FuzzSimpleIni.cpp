@@ -0,0 +1,47 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "Ini/SimpleIni.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// Whatever loads has to save, load again and save to the same text
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	CSimpleIniA ini;
+	ini.SetUnicode();
+	ini.SetMultiLine();
+	if (ini.LoadData(reinterpret_cast<const char*>(data), size) < 0)
+		return 0;
+
+	std::string saved;
+	if (ini.Save(saved) < 0)
+		abort();
+
+	CSimpleIniA reloaded;
+	reloaded.SetUnicode();
+	reloaded.SetMultiLine();
+	std::string savedAgain;
+	if (reloaded.LoadData(saved) < 0 || reloaded.Save(savedAgain) < 0)
+		abort();
+
+	// The lookup index answers like the trees
+	CSimpleIniA::TNamesDepend sections;
+	ini.GetAllSections(sections);
+	for (const auto& section : sections)
+	{
+		CSimpleIniA::TNamesDepend keys;
+		ini.GetAllKeys(section.pItem, keys);
+		for (const auto& key : keys)
+		{
+			const char* value = ini.GetValue(section.pItem, key.pItem);
+			ini.Freeze();
+			if (ini.GetValue(section.pItem, key.pItem) != value)
+				abort();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "Url.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	const std::wstring href(data, data + size);
+	const Url url = ParseUrl(href);
+
+	// Every component is a view into href
+	for (std::wstring_view part : { url.scheme, url.authority, url.userInfo, url.host, url.port, url.path, url.query, url.fragment })
+	{
+		if (!part.empty() && (url.Offset(part) > href.size() || url.Offset(part) + part.size() > href.size()))
+			abort();
+	}
+
+	std::wstring origin;
+	NormalizeUri(url, origin);
+	if (origin.size() > href.size() + 1)
+		abort();
+
+	// Resolving only normalizes slashes and adds a prefix
+	for (bool hasHostPath : { false, true })
+	{
+		const std::wstring resolved = ResolveUrl(href, hasHostPath, true, L"host", [](const std::wstring& path) { return path; });
+		if (resolved.size() < href.size() || resolved.empty() != href.empty())
+			abort();
+	}
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "Ini/SimpleIni.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	const char* input = reinterpret_cast<const char*>(data);
+
+	// The output never needs more units than there are input bytes
+	std::u16string utf16(size, u'\0');
+	const size_t utf16Size = SI_Utf8ToWide(input, size, &utf16[0], utf16.size());
+	std::u32string utf32(size, U'\0');
+	const size_t utf32Size = SI_Utf8ToWide(input, size, &utf32[0], utf32.size());
+	if (utf16Size == static_cast<size_t>(-1) || utf32Size == static_cast<size_t>(-1) || utf32Size > utf16Size)
+		abort();
+
+	// Decoded text is valid, so both widths encode to the same UTF-8 and decode back unchanged
+	std::string fromUtf16(utf16Size * 3, '\0');
+	std::string fromUtf32(utf32Size * 4, '\0');
+	fromUtf16.resize(SI_WideToUtf8(utf16.data(), utf16Size, &fromUtf16[0], fromUtf16.size()));
+	fromUtf32.resize(SI_WideToUtf8(utf32.data(), utf32Size, &fromUtf32[0], fromUtf32.size()));
+	if (fromUtf16 != fromUtf32)
+		abort();
+
+	std::u32string again(fromUtf32.size(), U'\0');
+	again.resize(SI_Utf8ToWide(fromUtf32.data(), fromUtf32.size(), &again[0], again.size()));
+	if (again != utf32.substr(0, utf32Size))
+		abort();
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+// Drives the platform independent halves of the plugin exports the way
+// Plugin.cpp does, against FakeRainmeter: the options fingerprint of Reload,
+// the coalesced actions of Update and the parsing of ExecuteBang. The WebView2
+// side of each export is left out.
+
+#include "FakeRainmeter.h"
+#include "BangCommand.h"
+#include "MeasureEvents.h"
+#include "ReloadOptions.h"
+#include "../API/RainmeterAPI.h"
+#include <array>
+#include <string>
+
+struct HeadlessMeasure
+{
+	explicit HeadlessMeasure(FakeSkin* skin) : rm(skin) {}
+
+	// Reload: nothing is read beyond the fingerprint while it is unchanged
+	void Reload()
+	{
+		const unsigned long long fingerprint = GetOptionsFingerprint(&rm);
+		if (hasOptionsFingerprint && fingerprint == optionsFingerprint)
+		{
+			++fastReloads;
+			return;
+		}
+
+		++fullReloads;
+		optionsFingerprint = fingerprint;
+		hasOptionsFingerprint = true;
+
+		width = ReadOptionInt(&rm, ReloadOption::W);
+		zoomFactor = ReadOptionFormula(&rm, ReloadOption::ZoomFactor);
+		url = ReadOptionString(&rm, ReloadOption::Url);
+		actions[0] = ReadOptionString(&rm, ReloadOption::OnStateChangeAction);
+		actions[1] = ReadOptionString(&rm, ReloadOption::OnUrlChangeAction);
+		actions[2] = ReadOptionString(&rm, ReloadOption::OnPageLoadStartAction);
+		actions[3] = ReadOptionString(&rm, ReloadOption::OnPageLoadingAction);
+		actions[4] = ReadOptionString(&rm, ReloadOption::OnPageDOMLoadAction);
+		actions[5] = ReadOptionString(&rm, ReloadOption::OnPageFirstLoadAction);
+		actions[6] = ReadOptionString(&rm, ReloadOption::OnPageReloadAction);
+		actions[7] = ReadOptionString(&rm, ReloadOption::OnPageLoadFinishAction);
+	}
+
+	// A WebView2 event with CoalesceActions=1
+	void NotifyAction(MeasureEvent event) { pendingEvents |= event; }
+
+	// Update: the queued actions run as one bang
+	void FlushActions()
+	{
+		if (pendingEvents == 0)
+			return;
+
+		deliveredEvents = pendingEvents;
+		pendingEvents = 0;
+
+		const std::wstring bang = BuildCoalescedBang(deliveredEvents,
+			[this](MeasureEvent event) -> const std::wstring& { return GetEventAction(event); });
+		if (!bang.empty())
+		{
+			RmExecute(rm.skin, bang.c_str());
+		}
+	}
+
+	// ExecuteBang: the command the plugin would dispatch
+	BangCommand ExecuteBang(const std::wstring& args) const { return ParseBang(args).command; }
+
+	const std::wstring& GetEventAction(MeasureEvent event) const
+	{
+		for (size_t bit = 0; bit < actions.size(); ++bit)
+		{
+			if (event == (1u << bit))
+				return actions[bit];
+		}
+
+		static const std::wstring none;
+		return none;
+	}
+
+	FakeMeasure rm;
+	unsigned long long optionsFingerprint = 0;
+	bool hasOptionsFingerprint = false;
+	size_t fullReloads = 0;
+	size_t fastReloads = 0;
+	unsigned int pendingEvents = 0;
+	unsigned int deliveredEvents = 0;
+	int width = 0;
+	double zoomFactor = 0.0;
+	std::wstring url;
+	std::array<std::wstring, 8> actions; // By the bit number of the event
+};
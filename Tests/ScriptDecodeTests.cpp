@@ -0,0 +1,73 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "ScriptDecode.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	// The decoding ReadScriptFile did before the mapped reader, one code unit at a time
+	std::u16string ReferenceDecode(const std::string& bytes)
+	{
+		const unsigned char* ub = reinterpret_cast<const unsigned char*>(bytes.data());
+		const size_t n = bytes.size();
+		std::u16string out;
+		if (n >= 2 && ub[0] == 0xFFu && ub[1] == 0xFEu)
+		{
+			for (size_t i = 2; i + 1 < n; i += 2) out.push_back(static_cast<char16_t>(ub[i] | (ub[i + 1] << 8)));
+			return out;
+		}
+		if (n >= 2 && ub[0] == 0xFEu && ub[1] == 0xFFu)
+		{
+			for (size_t i = 2; i + 1 < n; i += 2) out.push_back(static_cast<char16_t>((ub[i] << 8) | ub[i + 1]));
+			return out;
+		}
+
+		const size_t skip = (n >= 3 && ub[0] == 0xEFu && ub[1] == 0xBBu && ub[2] == 0xBFu) ? 3 : 0;
+		out.resize(n - skip);
+		out.resize(SI_Utf8ToWide(bytes.data() + skip, n - skip, &out[0], out.size()));
+		return out;
+	}
+
+	std::u16string Decode(const std::string& bytes)
+	{
+		std::u16string out;
+		EXPECT_TRUE(DecodeScriptBytes(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), out));
+		return out;
+	}
+}
+
+TEST(ScriptDecode, Boms)
+{
+	EXPECT_EQ(Decode(""), u"");
+	EXPECT_EQ(Decode("\xEF\xBB\xBF"), u"");
+	EXPECT_EQ(Decode("\xFF\xFE"), u"");
+	EXPECT_EQ(Decode("\xFE\xFF"), u"");
+	EXPECT_EQ(Decode("a=1;"), u"a=1;");
+	EXPECT_EQ(Decode("\xEF\xBB\xBF" "a\xE2\x82\xAC"), u"a€");
+	EXPECT_EQ(Decode(std::string("\xFF\xFE" "a\0\xAC\x20", 6)), u"a€");
+	EXPECT_EQ(Decode(std::string("\xFE\xFF\0a\x20\xAC", 6)), u"a€");
+
+	// A trailing odd byte is dropped
+	EXPECT_EQ(Decode(std::string("\xFE\xFF\0a\x20", 5)), u"a");
+}
+
+TEST(ScriptDecode, MatchesReferenceDecoder)
+{
+	static const char* const boms[] = { "", "\xEF\xBB\xBF", "\xFF\xFE", "\xFE\xFF" };
+
+	std::mt19937 engine(7);
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::string bytes = boms[i % std::size(boms)];
+		const size_t size = std::uniform_int_distribution<size_t>(0, 100)(engine);
+		for (size_t b = 0; b < size; ++b)
+		{
+			bytes += static_cast<char>(std::uniform_int_distribution<int>(0, 255)(engine));
+		}
+		EXPECT_EQ(Decode(bytes), ReferenceDecode(bytes)) << "case " << i;
+	}
+}
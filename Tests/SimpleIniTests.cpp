@@ -0,0 +1,388 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+// Differential tests of SimpleIni loading and saving. Random files are
+// generated together with the values they must load to, and every way of
+// loading, looking up and saving them has to agree with that model.
+
+#include "Ini/SimpleIni.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	struct IniKey
+	{
+		std::string name;
+		std::string value;
+	};
+
+	struct IniSection
+	{
+		std::string name;
+		std::vector<IniKey> keys;
+	};
+
+	// Expected content of a generated file, in load order
+	struct IniModel
+	{
+		std::vector<IniSection> sections;
+	};
+
+	class IniGenerator
+	{
+	public:
+		explicit IniGenerator(unsigned int seed) : engine(seed) {}
+
+		// Writes text and returns the values it has to load to
+		IniModel Generate(std::string& text, size_t sectionCount, size_t keyCount)
+		{
+			IniModel model;
+			const bool crlf = Chance(2);
+			const char* newline = crlf ? "\r\n" : "\n";
+
+			if (Chance(4)) text += "\xEF\xBB\xBF";
+
+			for (size_t s = 0; s < sectionCount; ++s)
+			{
+				IniSection section;
+				section.name = "Section" + std::to_string(s) + "_" + Word(0, 12);
+
+				AddFiller(text, newline);
+				text += Spaces() + "[" + Spaces() + section.name + Spaces() + "]" + Spaces() + newline;
+
+				for (size_t k = 0; k < keyCount; ++k)
+				{
+					IniKey key;
+					key.name = "Key" + std::to_string(k) + "_" + Word(0, 20);
+					key.value = Value();
+
+					AddFiller(text, newline);
+					text += Spaces() + key.name + Spaces() + "=" + Spaces() + key.value + Spaces() + newline;
+					section.keys.push_back(std::move(key));
+				}
+				model.sections.push_back(std::move(section));
+			}
+			return model;
+		}
+
+		size_t Index(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(engine); }
+
+		std::string Value()
+		{
+			// Long values cross the 16 byte blocks of the vector scan, and may
+			// contain the delimiters that only end a name
+			static const char chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 =]/\\.:;#[\"'";
+			const size_t length = std::uniform_int_distribution<size_t>(1, Chance(4) ? 80 : 24)(engine);
+			std::string value;
+			for (size_t i = 0; i < length; ++i)
+			{
+				value += chars[Index(sizeof(chars) - 1)];
+			}
+
+			// Values are trimmed and quotes are not parsed, keep the ends plain
+			value.front() = 'v';
+			value.back() = 'x';
+			return value;
+		}
+
+	private:
+		bool Chance(unsigned int n) { return Index(n) == 0; }
+
+		std::string Word(size_t minLength, size_t maxLength)
+		{
+			static const char chars[] = "abcdefghijklmnopqrstuvwxyz_0123456789";
+			const size_t length = std::uniform_int_distribution<size_t>(minLength, maxLength)(engine);
+			std::string word;
+			for (size_t i = 0; i < length; ++i)
+			{
+				word += chars[Index(sizeof(chars) - 1)];
+			}
+			return word;
+		}
+
+		std::string Spaces()
+		{
+			switch (Index(6))
+			{
+			case 0: return " ";
+			case 1: return "\t ";
+			default: return "";
+			}
+		}
+
+		void AddFiller(std::string& text, const char* newline)
+		{
+			switch (Index(8))
+			{
+			case 0: text += newline; break;
+			case 1: text += "; comment = with ] delimiters" + Word(0, 40) + newline; break;
+			case 2: text += "# " + Word(0, 40) + newline; break;
+			default: break;
+			}
+		}
+
+		std::mt19937 engine;
+	};
+
+	// Every model value, found through the name based lookups
+	void ExpectModel(const CSimpleIniA& ini, const IniModel& model)
+	{
+		CSimpleIniA::TNamesDepend sections;
+		ini.GetAllSections(sections);
+		ASSERT_EQ(sections.size(), model.sections.size());
+
+		sections.sort(CSimpleIniA::Entry::LoadOrder());
+		auto loaded = sections.begin();
+		for (const IniSection& section : model.sections)
+		{
+			EXPECT_STREQ(loaded->pItem, section.name.c_str());
+			++loaded;
+
+			EXPECT_EQ(ini.GetSectionSize(section.name.c_str()), static_cast<int>(section.keys.size()));
+			for (const IniKey& key : section.keys)
+			{
+				const char* value = ini.GetValue(section.name.c_str(), key.name.c_str(), nullptr);
+				ASSERT_NE(value, nullptr) << section.name << "." << key.name;
+				EXPECT_EQ(value, key.value) << section.name << "." << key.name;
+			}
+		}
+	}
+
+	// Case-folded and missing lookups, through names and precomputed handles
+	void ExpectLookups(const CSimpleIniA& ini, const IniModel& model)
+	{
+		for (const IniSection& section : model.sections)
+		{
+			std::string upperSection = section.name;
+			for (char& ch : upperSection) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+
+			for (const IniKey& key : section.keys)
+			{
+				const CSimpleIniA::KeyHandle handle(upperSection.c_str(), key.name.c_str());
+				const char* value = ini.GetValue(handle, nullptr);
+				ASSERT_NE(value, nullptr) << section.name << "." << key.name;
+				EXPECT_EQ(value, key.value);
+			}
+
+			EXPECT_EQ(ini.GetValue(section.name.c_str(), "MissingKey", nullptr), nullptr);
+		}
+		EXPECT_EQ(ini.GetValue("MissingSection", "Key0", nullptr), nullptr);
+	}
+
+	std::string Save(const CSimpleIniA& ini)
+	{
+		std::string text;
+		EXPECT_EQ(ini.Save(text), SI_OK);
+		return text;
+	}
+
+	class TempFile
+	{
+	public:
+		explicit TempFile(const std::string& text)
+		{
+			char name[] = "/tmp/SimpleIniTestsXXXXXX";
+			const int fd = mkstemp(name);
+			EXPECT_GE(fd, 0);
+			EXPECT_EQ(write(fd, text.data(), text.size()), static_cast<ssize_t>(text.size()));
+			close(fd);
+			path = name;
+		}
+		~TempFile() { remove(path.c_str()); }
+
+		const char* Path() const { return path.c_str(); }
+
+	private:
+		std::string path;
+	};
+
+	struct Shape
+	{
+		size_t sections;
+		size_t keys;
+	};
+
+	constexpr Shape kShapes[] = { { 1, 1 }, { 3, 7 }, { 12, 40 }, { 40, 3 } };
+	constexpr unsigned int kSeeds = 25;
+}
+
+TEST(SimpleIni, LoadDataMatchesModel)
+{
+	for (unsigned int seed = 0; seed < kSeeds; ++seed)
+	{
+		for (const Shape& shape : kShapes)
+		{
+			std::string text;
+			const IniModel model = IniGenerator(seed).Generate(text, shape.sections, shape.keys);
+
+			CSimpleIniA ini;
+			ini.SetUnicode();
+			ASSERT_EQ(ini.LoadData(text), SI_OK);
+			ExpectModel(ini, model);
+			ExpectLookups(ini, model);
+		}
+	}
+}
+
+TEST(SimpleIni, LoadFileMatchesLoadData)
+{
+	for (unsigned int seed = 0; seed < kSeeds; ++seed)
+	{
+		std::string text;
+		const IniModel model = IniGenerator(seed).Generate(text, 6, 20);
+		const TempFile file(text);
+
+		CSimpleIniA fromFile;
+		fromFile.SetUnicode();
+		ASSERT_EQ(fromFile.LoadFile(file.Path()), SI_OK);
+		ExpectModel(fromFile, model);
+
+		CSimpleIniA fromData;
+		fromData.SetUnicode();
+		ASSERT_EQ(fromData.LoadData(text), SI_OK);
+		EXPECT_EQ(Save(fromFile), Save(fromData));
+	}
+}
+
+TEST(SimpleIni, FrozenIndexMatchesTrees)
+{
+	for (unsigned int seed = 0; seed < kSeeds; ++seed)
+	{
+		std::string text;
+		const IniModel model = IniGenerator(seed).Generate(text, 8, 30);
+
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		ASSERT_EQ(ini.LoadData(text), SI_OK);
+		ini.Freeze();
+		ASSERT_TRUE(ini.IsFrozen());
+		ExpectModel(ini, model);
+		ExpectLookups(ini, model);
+
+		// Any change drops the index
+		ini.SetValue("Section0", "Added", "value");
+		EXPECT_FALSE(ini.IsFrozen());
+		EXPECT_STREQ(ini.GetValue("Section0", "Added", nullptr), "value");
+	}
+}
+
+TEST(SimpleIni, SaveRoundTrips)
+{
+	for (unsigned int seed = 0; seed < kSeeds; ++seed)
+	{
+		std::string text;
+		const IniModel model = IniGenerator(seed).Generate(text, 5, 12);
+
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		ASSERT_EQ(ini.LoadData(text), SI_OK);
+		const std::string saved = Save(ini);
+
+		CSimpleIniA reloaded;
+		reloaded.SetUnicode();
+		ASSERT_EQ(reloaded.LoadData(saved), SI_OK);
+		ExpectModel(reloaded, model);
+		EXPECT_EQ(Save(reloaded), saved);
+	}
+}
+
+// The same edits through the arena and through single allocations, with and
+// without reusing the saved text of unchanged sections, save the same file
+TEST(SimpleIni, EditsAgreeAcrossStorageModes)
+{
+	for (unsigned int seed = 0; seed < kSeeds; ++seed)
+	{
+		std::string text;
+		IniGenerator generator(seed);
+		IniModel model = generator.Generate(text, 6, 10);
+
+		CSimpleIniA plain, arena, incremental;
+		arena.SetArenaStrings();
+		incremental.SetIncrementalSave();
+		for (CSimpleIniA* ini : { &plain, &arena, &incremental })
+		{
+			ini->SetUnicode();
+			ASSERT_EQ(ini->LoadData(text), SI_OK);
+		}
+		ASSERT_TRUE(arena.UsingArenaStrings());
+
+		Save(incremental); // Keeps the text of every section
+		for (int round = 0; round < 20; ++round)
+		{
+			IniSection& section = model.sections[generator.Index(model.sections.size())];
+			const int action = static_cast<int>(generator.Index(3));
+			std::string keyName;
+			std::string value = generator.Value();
+
+			if (action == 0 && !section.keys.empty())
+			{
+				// Replace a value
+				IniKey& key = section.keys[generator.Index(section.keys.size())];
+				key.value = value;
+				keyName = key.name;
+			}
+			else if (action == 1)
+			{
+				// Add a key
+				keyName = "Added" + std::to_string(round);
+				section.keys.push_back({ keyName, value });
+			}
+			else if (!section.keys.empty())
+			{
+				// Delete a key
+				const size_t index = generator.Index(section.keys.size());
+				keyName = section.keys[index].name;
+				section.keys.erase(section.keys.begin() + index);
+				for (CSimpleIniA* ini : { &plain, &arena, &incremental })
+				{
+					EXPECT_TRUE(ini->Delete(section.name.c_str(), keyName.c_str()));
+				}
+				continue;
+			}
+			else
+			{
+				continue;
+			}
+
+			for (CSimpleIniA* ini : { &plain, &arena, &incremental })
+			{
+				ASSERT_GE(ini->SetValue(section.name.c_str(), keyName.c_str(), value.c_str()), 0);
+			}
+
+			if (round % 5 == 4)
+			{
+				const std::string expected = Save(plain);
+				EXPECT_EQ(Save(arena), expected);
+				EXPECT_EQ(Save(incremental), expected);
+			}
+		}
+
+		ExpectModel(plain, model);
+		ExpectModel(arena, model);
+		ExpectModel(incremental, model);
+	}
+}
+
+TEST(SimpleIni, LongLines)
+{
+	// Lines far longer than a vector block, with the delimiter at every offset
+	for (size_t offset = 0; offset < 40; ++offset)
+	{
+		const std::string name = "K" + std::string(offset, 'k');
+		const std::string value = std::string(100, 'v') + "=]" + std::string(offset, 'x');
+		const std::string text = "[S" + std::string(offset, 's') + "]\n" + name + "=" + value + "\n";
+
+		CSimpleIniA ini;
+		ini.SetUnicode();
+		ASSERT_EQ(ini.LoadData(text), SI_OK);
+		const std::string section = "S" + std::string(offset, 's');
+		EXPECT_STREQ(ini.GetValue(section.c_str(), name.c_str(), ""), value.c_str());
+	}
+}
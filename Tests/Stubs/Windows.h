@@ -0,0 +1,29 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+// The few Windows types and macros the portable sources and RainmeterAPI.h
+// use, for building them on other systems. Only on the include path there.
+
+#include <cstddef>
+
+typedef int BOOL;
+typedef wchar_t WCHAR;
+typedef const wchar_t* LPCWSTR;
+typedef void* HWND;
+typedef void* HMODULE;
+
+#define TRUE 1
+#define FALSE 0
+
+#define EXTERN_C extern "C"
+#define __stdcall
+#define __cdecl
+#define __declspec(attribute)
+#define __inline inline
+
+// RainmeterAPI.h resolves optional exports at run time, there are none here
+#define GetModuleHandle(name) static_cast<HMODULE>(nullptr)
+#define GetProcAddress(module, name) nullptr
@@ -0,0 +1,140 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "Url.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(Url, ParseComponents)
+{
+	struct Case
+	{
+		const wchar_t* href;
+		const wchar_t* scheme;
+		bool hasAuthority;
+		const wchar_t* userInfo;
+		const wchar_t* host;
+		const wchar_t* port;
+		const wchar_t* path;
+		const wchar_t* query;
+		const wchar_t* fragment;
+	};
+
+	const Case cases[] =
+	{
+		{ L"https://example.com", L"https", true, L"", L"example.com", L"", L"", L"", L"" },
+		{ L"https://user:pw@example.com:8080/a/b?x=1&y=/2#frag/x", L"https", true, L"user:pw", L"example.com", L"8080", L"/a/b", L"x=1&y=/2", L"frag/x" },
+		{ L"http://[::1]:80/", L"http", true, L"", L"[::1]", L"80", L"/", L"", L"" },
+		{ L"http://[::1]/", L"http", true, L"", L"[::1]", L"", L"/", L"", L"" },
+		{ L"file:///C:/Skins/index.html", L"file", true, L"", L"", L"", L"/C:/Skins/index.html", L"", L"" },
+		{ L"view-source:https://h/x", L"view-source", false, L"", L"", L"", L"https://h/x", L"", L"" },
+		{ L"about:blank", L"about", false, L"", L"", L"", L"blank", L"", L"" },
+		{ L"localhost:8080", L"localhost", false, L"", L"", L"", L"8080", L"", L"" },
+		{ L"index.html?q#f", L"", false, L"", L"", L"", L"index.html", L"q", L"f" },
+		{ L"//cdn.example.com/lib.js", L"", true, L"", L"cdn.example.com", L"", L"/lib.js", L"", L"" },
+		{ L"1http://x", L"", false, L"", L"", L"", L"1http://x", L"", L"" },
+		{ L"", L"", false, L"", L"", L"", L"", L"", L"" },
+	};
+
+	for (const Case& test : cases)
+	{
+		const Url url = ParseUrl(test.href);
+		const std::string href(test.href, test.href + wcslen(test.href));
+		EXPECT_EQ(url.scheme, test.scheme) << href;
+		EXPECT_EQ(url.hasAuthority, test.hasAuthority) << href;
+		EXPECT_EQ(url.userInfo, test.userInfo) << href;
+		EXPECT_EQ(url.host, test.host) << href;
+		EXPECT_EQ(url.port, test.port) << href;
+		EXPECT_EQ(url.path, test.path) << href;
+		EXPECT_EQ(url.query, test.query) << href;
+		EXPECT_EQ(url.fragment, test.fragment) << href;
+	}
+}
+
+TEST(Url, SchemeAndHostIgnoreCase)
+{
+	const Url url = ParseUrl(L"HTTPS://Example.COM/Path");
+	EXPECT_TRUE(url.IsScheme(L"https"));
+	EXPECT_TRUE(url.IsHost(L"example.com"));
+	EXPECT_FALSE(url.IsHost(L"example.co"));
+	EXPECT_EQ(url.Origin(), L"HTTPS://Example.COM");
+	EXPECT_EQ(ParseUrl(L"view-source:https://h/x").SchemeSpecificPart(), L"https://h/x");
+}
+
+TEST(Url, NormalizeUri)
+{
+	struct Case
+	{
+		const wchar_t* href;
+		const wchar_t* origin;
+	};
+
+	const Case cases[] =
+	{
+		{ L"https://example.com/a/b.html?x=1", L"https://example.com/" },
+		{ L"https://example.com", L"https://example.com/" },
+		{ L"https://user@example.com:8080/a", L"https://user@example.com:8080/" },
+		{ L"file:///C:/Skins/index.html", L"file:///C:/Skins/" },
+		{ L"file:///C:/Skins/index.html?page=/other#/x", L"file:///C:/Skins/" },
+		{ L"view-source:https://h/x", L"view-source:https://h/" },
+		{ L"view-source:file:///C:/a/b.html", L"view-source:file:///" },
+		{ L"blob:https://h:1/uuid", L"blob:https://h:1/" },
+		{ L"about:blank", L"about:blank" },
+		{ L"localhost:8080", L"localhost:8080" },
+		{ L"index.html", L"index.html" },
+	};
+
+	std::wstring origin;
+	for (const Case& test : cases)
+	{
+		NormalizeUri(std::wstring_view(test.href), origin);
+		EXPECT_EQ(origin, test.origin) << std::string(test.href, test.href + wcslen(test.href));
+	}
+}
+
+TEST(Url, ResolveUrl)
+{
+	struct Case
+	{
+		const wchar_t* url;
+		bool hasHostPath;
+		bool hostSecurity;
+		const wchar_t* resolved;
+	};
+
+	const Case cases[] =
+	{
+		{ L"", false, true, L"" },
+		{ L"https://example.com/a", false, true, L"https://example.com/a" },
+		{ L"https://example.com/a", true, true, L"https://example.com/a" },
+		{ L"C:\\Skins\\index.html", false, true, L"C:\\Skins\\index.html" },
+		{ L"/index.html", true, true, L"/index.html" },
+		{ L"index.html", false, true, L"file:///C:/Skins/index.html" },
+		{ L"sub\\page.html", false, true, L"file:///C:/Skins/sub/page.html" },
+		{ L"file:///C:/x.html", false, true, L"file:///C:/x.html" },
+		{ L"file:C:/x.html", false, true, L"file:///C:/Skins/file:C:/x.html" },
+		{ L"view-source:https://example.com/", false, true, L"view-source:https://example.com/" },
+		{ L"view-source:index.html", false, true, L"file:///C:/Skins/view-source:index.html" },
+		{ L"about:blank", false, true, L"file:///C:/Skins/about:blank" },
+		{ L"localhost:8080", false, true, L"file:///C:/Skins/localhost:8080" },
+		{ L"localhost:8080", true, true, L"https://skin.local/localhost:8080" },
+		{ L"index.html", true, true, L"https://skin.local/index.html" },
+		{ L"index.html", true, false, L"http://skin.local/index.html" },
+		{ L"\\index.html", true, true, L"https://skin.local\\index.html" },
+		{ L"a", true, true, L"https://skin.local/a" },
+	};
+
+	// Stands in for RmPathToAbsolute, which resolves against the skin folder
+	// and keeps absolute file URLs
+	auto toAbsolute = [](const std::wstring& path) -> std::wstring
+	{
+		return path.compare(0, 8, L"file:///") == 0 ? path : L"C:\\Skins\\" + path;
+	};
+
+	for (const Case& test : cases)
+	{
+		EXPECT_EQ(ResolveUrl(test.url, test.hasHostPath, test.hostSecurity, L"skin.local", toAbsolute), test.resolved)
+			<< std::string(test.url, test.url + wcslen(test.url));
+	}
+}
@@ -0,0 +1,197 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+// SI_Utf8ToWide and SI_WideToUtf8 against a byte-at-a-time reference decoder
+// that replaces each maximal invalid subpart with one U+FFFD
+
+#include "Ini/SimpleIni.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::u32string ReferenceDecode(const std::string& input)
+	{
+		const unsigned char* in = reinterpret_cast<const unsigned char*>(input.data());
+		const size_t size = input.size();
+		std::u32string out;
+
+		size_t i = 0;
+		while (i < size)
+		{
+			const unsigned int lead = in[i++];
+			if (lead < 0x80)
+			{
+				out += static_cast<char32_t>(lead);
+				continue;
+			}
+
+			// Unicode Table 3-7, well-formed UTF-8 byte sequences
+			size_t need = 0;
+			unsigned int low = 0x80, high = 0xBF, codePoint = 0;
+			if (lead >= 0xC2 && lead <= 0xDF) { need = 1; codePoint = lead & 0x1F; }
+			else if (lead == 0xE0) { need = 2; low = 0xA0; codePoint = 0; }
+			else if (lead >= 0xE1 && lead <= 0xEC) { need = 2; codePoint = lead & 0x0F; }
+			else if (lead == 0xED) { need = 2; high = 0x9F; codePoint = 0x0D; }
+			else if (lead >= 0xEE && lead <= 0xEF) { need = 2; codePoint = lead & 0x0F; }
+			else if (lead == 0xF0) { need = 3; low = 0x90; codePoint = 0; }
+			else if (lead >= 0xF1 && lead <= 0xF3) { need = 3; codePoint = lead & 0x07; }
+			else if (lead == 0xF4) { need = 3; high = 0x8F; codePoint = 4; }
+			else
+			{
+				out += U'\xFFFD';
+				continue;
+			}
+
+			size_t have = 0;
+			while (have < need && i < size && in[i] >= low && in[i] <= high)
+			{
+				codePoint = (codePoint << 6) | (in[i] & 0x3F);
+				low = 0x80;
+				high = 0xBF;
+				++have;
+				++i;
+			}
+			out += (have == need) ? static_cast<char32_t>(codePoint) : U'\xFFFD';
+		}
+		return out;
+	}
+
+	std::u16string ToUtf16(const std::u32string& text)
+	{
+		std::u16string out;
+		for (char32_t ch : text)
+		{
+			if (ch >= 0x10000)
+			{
+				out += static_cast<char16_t>(0xD800 + ((ch - 0x10000) >> 10));
+				out += static_cast<char16_t>(0xDC00 + ((ch - 0x10000) & 0x3FF));
+			}
+			else
+			{
+				out += static_cast<char16_t>(ch);
+			}
+		}
+		return out;
+	}
+
+	template<class Char>
+	std::basic_string<Char> Decode(const std::string& input)
+	{
+		// The output never needs more units than there are input bytes
+		std::basic_string<Char> out(input.size(), Char());
+		const size_t written = SI_Utf8ToWide(input.data(), input.size(), &out[0], out.size());
+		EXPECT_NE(written, static_cast<size_t>(-1));
+		out.resize(written == static_cast<size_t>(-1) ? 0 : written);
+		return out;
+	}
+
+	template<class Char>
+	std::string Encode(const std::basic_string<Char>& input)
+	{
+		// Three bytes per UTF-16 unit, four per code point above U+FFFF
+		std::string out(input.size() * (sizeof(Char) == 2 ? 3 : 4), '\0');
+		const size_t written = SI_WideToUtf8(input.data(), input.size(), &out[0], out.size());
+		EXPECT_NE(written, static_cast<size_t>(-1));
+		out.resize(written == static_cast<size_t>(-1) ? 0 : written);
+		return out;
+	}
+
+	// Mostly ASCII runs long enough for the vector path, mixed with valid and
+	// broken multi-byte sequences
+	std::string RandomUtf8(std::mt19937& random)
+	{
+		static const std::string pieces[] =
+		{
+			"abcdefghijklmnopqrstuvwxyz0123456789", "a", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+			"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xBF", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80",
+			"\xF4\x90\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF", "\xEF\xBB\xBF", std::string(1, '\0'),
+		};
+		std::string text;
+		const size_t count = std::uniform_int_distribution<size_t>(0, 30)(random);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t piece = std::uniform_int_distribution<size_t>(0, std::size(pieces) - 1)(random);
+			text += pieces[piece];
+		}
+		return text;
+	}
+}
+
+TEST(Utf8, KnownSequences)
+{
+	struct Case
+	{
+		const char* input;
+		std::u32string expected;
+	};
+
+	const Case cases[] =
+	{
+		{ "", U"" },
+		{ "plain ASCII text longer than sixteen bytes", U"plain ASCII text longer than sixteen bytes" },
+		{ "\xC3\xA9t\xC3\xA9", U"\u00E9t\u00E9" },
+		{ "\xE2\x82\xAC", U"\u20AC" },
+		{ "\xF0\x9F\x98\x80", U"\U0001F600" },
+		{ "\xF4\x8F\xBF\xBF", U"\U0010FFFF" },
+		{ "\xC0\xAF", U"\uFFFD\uFFFD" },                 // Overlong
+		{ "\xE0\x80\xAF", U"\uFFFD\uFFFD\uFFFD" },        // Overlong
+		{ "\xED\xA0\x80", U"\uFFFD\uFFFD\uFFFD" },        // Surrogate
+		{ "\xF4\x90\x80\x80", U"\uFFFD\uFFFD\uFFFD\uFFFD" }, // Above U+10FFFF
+		{ "\xE2\x82", U"\uFFFD" },                        // Truncated at the end
+		{ "\xE2\x82" "a", U"\uFFFDa" },                   // Truncated before ASCII
+		{ "\xF0\x9F\x98" "0123456789abcdef", U"\uFFFD" U"0123456789abcdef" },
+		{ "\x80\xBF", U"\uFFFD\uFFFD" },
+	};
+
+	for (const Case& test : cases)
+	{
+		const std::string input = test.input;
+		EXPECT_EQ(ReferenceDecode(input), test.expected) << input;
+		EXPECT_EQ(Decode<char32_t>(input), test.expected) << input;
+		EXPECT_EQ(Decode<char16_t>(input), ToUtf16(test.expected)) << input;
+	}
+}
+
+TEST(Utf8, MatchesReferenceDecoder)
+{
+	std::mt19937 random(1);
+	for (int i = 0; i < 20000; ++i)
+	{
+		const std::string input = RandomUtf8(random);
+		const std::u32string expected = ReferenceDecode(input);
+		ASSERT_EQ(Decode<char32_t>(input), expected);
+		ASSERT_EQ(Decode<char16_t>(input), ToUtf16(expected));
+	}
+}
+
+TEST(Utf8, SmallOutputBuffer)
+{
+	const std::string input = "0123456789abcdef0123456789abcdef\xF0\x9F\x98\x80";
+	std::u16string out(input.size(), u'\0');
+
+	// One unit short of the surrogate pair
+	EXPECT_EQ(SI_Utf8ToWide(input.data(), input.size(), &out[0], 33), static_cast<size_t>(-1));
+	EXPECT_EQ(SI_Utf8ToWide(input.data(), input.size(), &out[0], 34), 34u);
+	EXPECT_EQ(SI_Utf8ToWide(input.data(), input.size(), &out[0], 10), static_cast<size_t>(-1));
+}
+
+TEST(Utf8, WideRoundTrip)
+{
+	std::mt19937 random(2);
+	for (int i = 0; i < 5000; ++i)
+	{
+		// Decoding replaces every error, so the decoded text encodes back to valid UTF-8
+		const std::u32string text = ReferenceDecode(RandomUtf8(random));
+		const std::string utf8 = Encode(text);
+		ASSERT_EQ(ReferenceDecode(utf8), text);
+		ASSERT_EQ(Encode(ToUtf16(text)), utf8);
+	}
+
+	// Unpaired surrogates are written as U+FFFD
+	EXPECT_EQ(Encode(std::u16string{ u'a', static_cast<char16_t>(0xD800), u'b' }), "a\xEF\xBF\xBD" "b");
+	EXPECT_EQ(Encode(std::u16string(1, static_cast<char16_t>(0xDC00))), "\xEF\xBF\xBD");
+}
@@ -0,0 +1,197 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "BangCommand.h"
+#include <cstdint>
+
+namespace
+{
+	// Lower-case names; takesArgs entries accept text after the sub-command,
+	// entries without a sub-command catch everything else for their action
+	struct BangCommandName
+	{
+		const wchar_t* name;
+		BangCommand command;
+		bool takesArgs;
+	};
+
+	constexpr BangCommandName g_bangCommands[] =
+	{
+		{ L"webview", BangCommand::WebViewUnknown, true },
+		{ L"webview start", BangCommand::WebViewStart, false },
+		{ L"webview stop", BangCommand::WebViewStop, false },
+		{ L"webview restart", BangCommand::WebViewRestart, false },
+		{ L"navigate", BangCommand::NavigateUrl, true },
+		{ L"navigate stop", BangCommand::NavigateStop, false },
+		{ L"navigate reload", BangCommand::NavigateReload, false },
+		{ L"navigate back", BangCommand::NavigateBack, false },
+		{ L"navigate forward", BangCommand::NavigateForward, false },
+		{ L"navigate home", BangCommand::NavigateHome, false },
+		{ L"open", BangCommand::OpenUnknown, true },
+		{ L"open devtools", BangCommand::OpenDevTools, false },
+		{ L"open taskmanager", BangCommand::OpenTaskManager, false },
+		{ L"execute", BangCommand::Execute, true },
+		{ L"script", BangCommand::ScriptUnknown, true },
+		{ L"script register", BangCommand::ScriptRegister, true },
+		{ L"script run", BangCommand::ScriptRun, true },
+		{ L"batch", BangCommand::Batch, true },
+	};
+
+	constexpr size_t kCommandCount = sizeof(g_bangCommands) / sizeof(g_bangCommands[0]);
+	constexpr size_t kSlotCount = 64;
+	static_assert(kCommandCount < kSlotCount, "Too many bang commands for the hash table");
+
+	constexpr wchar_t Fold(wchar_t ch)
+	{
+		return (ch >= L'A' && ch <= L'Z') ? static_cast<wchar_t>(ch + (L'a' - L'A')) : ch;
+	}
+
+	// FNV-1a over case-folded characters, seeded to make the table collision-free
+	constexpr uint32_t HashStep(uint32_t hash, wchar_t ch)
+	{
+		return (hash ^ static_cast<uint32_t>(Fold(ch))) * 16777619u;
+	}
+
+	constexpr uint32_t HashName(uint32_t hash, const wchar_t* name)
+	{
+		while (*name) hash = HashStep(hash, *name++);
+		return hash;
+	}
+
+	uint32_t HashView(uint32_t hash, std::wstring_view text)
+	{
+		for (wchar_t ch : text) hash = HashStep(hash, ch);
+		return hash;
+	}
+
+	constexpr bool IsPerfectSeed(uint32_t seed)
+	{
+		bool used[kSlotCount] = {};
+		for (size_t i = 0; i < kCommandCount; ++i)
+		{
+			const size_t slot = HashName(seed, g_bangCommands[i].name) & (kSlotCount - 1);
+			if (used[slot])
+				return false;
+			used[slot] = true;
+		}
+		return true;
+	}
+
+	constexpr uint32_t FindSeed()
+	{
+		for (uint32_t seed = 2166136261u; seed < 2166136261u + 100000u; ++seed)
+		{
+			if (IsPerfectSeed(seed))
+				return seed;
+		}
+		return 0;
+	}
+
+	constexpr uint32_t kSeed = FindSeed();
+	static_assert(kSeed != 0, "No collision-free seed for the bang command table");
+
+	// Slot -> 1-based index into g_bangCommands, 0 for empty slots
+	struct SlotTable
+	{
+		uint8_t index[kSlotCount];
+	};
+
+	constexpr SlotTable BuildSlots()
+	{
+		SlotTable table = {};
+		for (size_t i = 0; i < kCommandCount; ++i)
+		{
+			table.index[HashName(kSeed, g_bangCommands[i].name) & (kSlotCount - 1)] = static_cast<uint8_t>(i + 1);
+		}
+		return table;
+	}
+
+	constexpr SlotTable kSlots = BuildSlots();
+
+	// A hit still has to be confirmed, the hash only rules out everything else
+	const BangCommandName* FindCommand(uint32_t hash, std::wstring_view action, std::wstring_view subAction)
+	{
+		const uint8_t index = kSlots.index[hash & (kSlotCount - 1)];
+		if (index == 0)
+			return nullptr;
+
+		const BangCommandName& entry = g_bangCommands[index - 1];
+		const wchar_t* name = entry.name;
+
+		for (wchar_t ch : action)
+		{
+			if (*name == L'\0' || *name != Fold(ch))
+				return nullptr;
+			++name;
+		}
+
+		if (!subAction.empty())
+		{
+			if (*name != L' ')
+				return nullptr;
+			++name;
+
+			for (wchar_t ch : subAction)
+			{
+				if (*name == L'\0' || *name != Fold(ch))
+					return nullptr;
+				++name;
+			}
+		}
+
+		return *name == L'\0' ? &entry : nullptr;
+	}
+}
+
+ParsedBang ParseBang(std::wstring_view args)
+{
+	ParsedBang bang;
+
+	const size_t spacePos = args.find(L' ');
+	bang.action = args.substr(0, spacePos);
+	bang.param = args.substr(spacePos != std::wstring_view::npos ? spacePos + 1 : args.size());
+
+	const uint32_t actionHash = HashView(kSeed, bang.action);
+
+	// "Action SubAction [args]"
+	const size_t subPos = bang.param.find(L' ');
+	const std::wstring_view subAction = bang.param.substr(0, subPos);
+	if (!subAction.empty())
+	{
+		const uint32_t hash = HashView(HashStep(actionHash, L' '), subAction);
+		const BangCommandName* entry = FindCommand(hash, bang.action, subAction);
+		if (entry && (entry->takesArgs || subPos == std::wstring_view::npos))
+		{
+			bang.command = entry->command;
+			bang.param = bang.param.substr(subPos != std::wstring_view::npos ? subPos + 1 : bang.param.size());
+			return bang;
+		}
+	}
+
+	// "Action param"
+	if (const BangCommandName* entry = FindCommand(actionHash, bang.action, {}))
+	{
+		bang.command = entry->command;
+	}
+
+	return bang;
+}
+
+void AppendAction(std::wstring& bang, std::wstring_view action)
+{
+	const size_t start = action.find_first_not_of(L" \t");
+	if (start == std::wstring_view::npos)
+		return;
+
+	action.remove_prefix(start);
+	if (action.front() == L'[')
+	{
+		bang += action;
+		return;
+	}
+
+	bang += L'[';
+	bang += action;
+	bang += L']';
+}
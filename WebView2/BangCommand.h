@@ -0,0 +1,47 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+enum class BangCommand
+{
+	Unknown,
+	WebViewStart,
+	WebViewStop,
+	WebViewRestart,
+	WebViewUnknown,
+	NavigateUrl,
+	NavigateStop,
+	NavigateReload,
+	NavigateBack,
+	NavigateForward,
+	NavigateHome,
+	OpenDevTools,
+	OpenTaskManager,
+	OpenUnknown,
+	Execute,
+	ScriptRegister,
+	ScriptRun,
+	ScriptUnknown,
+	Batch
+};
+
+struct ParsedBang
+{
+	BangCommand command = BangCommand::Unknown;
+	std::wstring_view action;
+	std::wstring_view param; // Ends where args ends, so param.data() stays null-terminated
+};
+
+// Splits "Action [SubAction] [Param]" and resolves it through a perfect hash
+// over the case-folded command names, without allocating
+ParsedBang ParseBang(std::wstring_view args);
+
+// Appends a Rainmeter action to bang so several actions run with one RmExecute.
+// Actions already in brackets, such as "[!A][!B]", are appended as they are,
+// a single bang or command such as "!A" is wrapped in brackets.
+void AppendAction(std::wstring& bang, std::wstring_view action);
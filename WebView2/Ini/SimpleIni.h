@@ -237,6 +237,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 #include <algorithm>
 #include <stdio.h>
 
@@ -268,6 +269,9 @@ constexpr int SI_FILE = -3;     //!< File error (see errno for detail error)
 //! to prevent excessive memory allocation and potential denial of service.
 constexpr size_t SI_MAX_FILE_SIZE = 1024ULL * 1024ULL * 1024ULL;
 
+//! Number of characters in each chunk of the string arena (see SetArenaStrings)
+constexpr size_t SI_ARENA_CHUNK_SIZE = 4096;
+
 #define SI_UTF8_SIGNATURE     "\xEF\xBB\xBF"
 
 #ifdef _WIN32
@@ -290,6 +294,369 @@ constexpr size_t SI_MAX_FILE_SIZE = 1024ULL * 1024ULL * 1024ULL;
 # define SI_WCHAR_T     UChar
 #endif
 
+// LoadFile() maps the file into memory where the platform supports it, so
+// the raw file data is converted straight from the page cache instead of
+// being read into a temporary heap buffer first. Define SI_NO_MMAP to always
+// read files through stdio.
+#if !defined(SI_NO_MMAP)
+# if defined(_WIN32)
+#  define SI_HAS_MMAP
+#  include <windows.h>
+# elif defined(__unix__) || defined(__APPLE__)
+#  define SI_HAS_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+# endif
+#endif // SI_NO_MMAP
+
+// FindEntry() locates line ends and the ']' and '=' delimiters with SSE2
+// where available, 16 bytes at a time for both 8 and 16 bit characters.
+// Define SI_NO_SIMD to always use the scalar scan.
+#if !defined(SI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+# define SI_HAS_SSE2
+# include <emmintrin.h>
+# include <stdint.h>
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+#endif // SI_NO_SIMD
+
+// The vector scan reads whole aligned 16 byte blocks, which never cross a
+// page boundary but may read past the terminating NULL of the buffer.
+#if defined(__clang__) || defined(__GNUC__)
+# define SI_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+# define SI_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+# define SI_NO_SANITIZE_ADDRESS
+#endif
+
+/** Scan forward to the first NULL, newline or a_chDelim character.
+    Pass a NULL delimiter to stop at the end of the line only. This is the
+    scalar implementation, used for characters that have no vector scan.
+ */
+template<class SI_CHAR, size_t SI_CHAR_SIZE = sizeof(SI_CHAR)>
+struct SI_LineScanner {
+    static SI_CHAR * Find(SI_CHAR * a_pData, SI_CHAR a_chDelim) {
+        while (*a_pData && *a_pData != a_chDelim
+            && *a_pData != '\n' && *a_pData != '\r')
+        {
+            ++a_pData;
+        }
+        return a_pData;
+    }
+};
+
+#ifdef SI_HAS_SSE2
+inline unsigned int SI_FirstSetBit(unsigned int a_uMask) {
+#ifdef _MSC_VER
+    unsigned long uIndex;
+    _BitScanForward(&uIndex, a_uMask);
+    return uIndex;
+#else
+    return static_cast<unsigned int>(__builtin_ctz(a_uMask));
+#endif
+}
+
+template<class SI_CHAR>
+struct SI_LineScanner<SI_CHAR, 1> {
+    SI_NO_SANITIZE_ADDRESS
+    static SI_CHAR * Find(SI_CHAR * a_pData, SI_CHAR a_chDelim) {
+        // scalar scan up to the first aligned block
+        while (reinterpret_cast<uintptr_t>(a_pData) & 15) {
+            if (!*a_pData || *a_pData == a_chDelim
+                || *a_pData == '\n' || *a_pData == '\r')
+            {
+                return a_pData;
+            }
+            ++a_pData;
+        }
+
+        const __m128i vNull  = _mm_setzero_si128();
+        const __m128i vLf    = _mm_set1_epi8('\n');
+        const __m128i vCr    = _mm_set1_epi8('\r');
+        const __m128i vDelim = _mm_set1_epi8(static_cast<char>(a_chDelim));
+        for (;;) {
+            __m128i vData = _mm_load_si128(reinterpret_cast<const __m128i *>(a_pData));
+            __m128i vStop = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(vData, vNull), _mm_cmpeq_epi8(vData, vLf)),
+                _mm_or_si128(_mm_cmpeq_epi8(vData, vCr), _mm_cmpeq_epi8(vData, vDelim)));
+            unsigned int uMask = static_cast<unsigned int>(_mm_movemask_epi8(vStop));
+            if (uMask) {
+                return a_pData + SI_FirstSetBit(uMask);
+            }
+            a_pData += 16;
+        }
+    }
+};
+
+template<class SI_CHAR>
+struct SI_LineScanner<SI_CHAR, 2> {
+    SI_NO_SANITIZE_ADDRESS
+    static SI_CHAR * Find(SI_CHAR * a_pData, SI_CHAR a_chDelim) {
+        // scalar scan up to the first aligned block
+        while (reinterpret_cast<uintptr_t>(a_pData) & 15) {
+            if (!*a_pData || *a_pData == a_chDelim
+                || *a_pData == '\n' || *a_pData == '\r')
+            {
+                return a_pData;
+            }
+            ++a_pData;
+        }
+
+        const __m128i vNull  = _mm_setzero_si128();
+        const __m128i vLf    = _mm_set1_epi16('\n');
+        const __m128i vCr    = _mm_set1_epi16('\r');
+        const __m128i vDelim = _mm_set1_epi16(static_cast<short>(a_chDelim));
+        for (;;) {
+            __m128i vData = _mm_load_si128(reinterpret_cast<const __m128i *>(a_pData));
+            __m128i vStop = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi16(vData, vNull), _mm_cmpeq_epi16(vData, vLf)),
+                _mm_or_si128(_mm_cmpeq_epi16(vData, vCr), _mm_cmpeq_epi16(vData, vDelim)));
+            unsigned int uMask = static_cast<unsigned int>(_mm_movemask_epi8(vStop));
+            if (uMask) {
+                // two mask bits per character
+                return a_pData + SI_FirstSetBit(uMask) / 2;
+            }
+            a_pData += 8;
+        }
+    }
+};
+#endif // SI_HAS_SSE2
+
+/** Convert UTF-8 to UTF-16 (2 byte SI_WCHAR) or UTF-32 (4 byte SI_WCHAR).
+    Runs of ASCII are widened 16 bytes at a time where SSE2 is available.
+    Invalid sequences are replaced by one U+FFFD for each maximal invalid
+    subpart, the same as MultiByteToWideChar. The output never needs more
+    units than there are input bytes.
+
+    @param a_pIn        UTF-8 data, embedded NULL bytes are converted
+    @param a_uInLen     Length of the input in bytes
+    @param a_pOut       Output buffer
+    @param a_uOutSize   Size of the output buffer in SI_WCHAR
+
+    @return             Number of SI_WCHAR written, or -1 cast to size_t if
+                        the output buffer is too small.
+ */
+template<class SI_WCHAR>
+size_t SI_Utf8ToWide(
+    const char *    a_pIn,
+    size_t          a_uInLen,
+    SI_WCHAR *      a_pOut,
+    size_t          a_uOutSize
+    )
+{
+    const unsigned char * pIn = reinterpret_cast<const unsigned char *>(a_pIn);
+    const unsigned char * pInEnd = pIn + a_uInLen;
+    SI_WCHAR * pOut = a_pOut;
+    SI_WCHAR * pOutEnd = a_pOut + a_uOutSize;
+
+    while (pIn < pInEnd) {
+#ifdef SI_HAS_SSE2
+        // widen 16 ASCII characters at a time
+        if (sizeof(SI_WCHAR) == 2 || sizeof(SI_WCHAR) == 4) {
+            const __m128i vZero = _mm_setzero_si128();
+            while (pInEnd - pIn >= 16 && pOutEnd - pOut >= 16) {
+                __m128i vData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pIn));
+                if (_mm_movemask_epi8(vData)) {
+                    break;
+                }
+                __m128i vLow  = _mm_unpacklo_epi8(vData, vZero);
+                __m128i vHigh = _mm_unpackhi_epi8(vData, vZero);
+                __m128i * pStore = reinterpret_cast<__m128i *>(pOut);
+                if (sizeof(SI_WCHAR) == 2) {
+                    _mm_storeu_si128(pStore,     vLow);
+                    _mm_storeu_si128(pStore + 1, vHigh);
+                }
+                else {
+                    _mm_storeu_si128(pStore,     _mm_unpacklo_epi16(vLow, vZero));
+                    _mm_storeu_si128(pStore + 1, _mm_unpackhi_epi16(vLow, vZero));
+                    _mm_storeu_si128(pStore + 2, _mm_unpacklo_epi16(vHigh, vZero));
+                    _mm_storeu_si128(pStore + 3, _mm_unpackhi_epi16(vHigh, vZero));
+                }
+                pIn  += 16;
+                pOut += 16;
+            }
+            if (pIn == pInEnd) {
+                break;
+            }
+        }
+#endif // SI_HAS_SSE2
+
+        if (pOut == pOutEnd) {
+            return (size_t)(-1);
+        }
+
+        unsigned int uChar = *pIn++;
+        if (uChar < 0x80) {
+            *pOut++ = static_cast<SI_WCHAR>(uChar);
+            continue;
+        }
+
+        // determine the sequence length and the valid range of the second
+        // byte, which excludes overlong forms, surrogates and > U+10FFFF
+        size_t uNeed;
+        unsigned int uLow = 0x80, uHigh = 0xBF;
+        if (uChar >= 0xC2 && uChar <= 0xDF) {
+            uNeed = 1;
+            uChar &= 0x1F;
+        }
+        else if (uChar >= 0xE0 && uChar <= 0xEF) {
+            uNeed = 2;
+            uChar &= 0x0F;
+            if (uChar == 0x00) uLow = 0xA0;
+            else if (uChar == 0x0D) uHigh = 0x9F;
+        }
+        else if (uChar >= 0xF0 && uChar <= 0xF4) {
+            uNeed = 3;
+            uChar &= 0x07;
+            if (uChar == 0x00) uLow = 0x90;
+            else if (uChar == 0x04) uHigh = 0x8F;
+        }
+        else {
+            *pOut++ = static_cast<SI_WCHAR>(0xFFFD);
+            continue;
+        }
+
+        size_t uHave = 0;
+        for ( ; uHave < uNeed && pIn < pInEnd; ++uHave, ++pIn) {
+            unsigned int uNext = *pIn;
+            if (uNext < uLow || uNext > uHigh) {
+                break;
+            }
+            uChar = (uChar << 6) | (uNext & 0x3F);
+            uLow = 0x80;
+            uHigh = 0xBF;
+        }
+        if (uHave < uNeed) {
+            *pOut++ = static_cast<SI_WCHAR>(0xFFFD);
+            continue;
+        }
+
+        if (sizeof(SI_WCHAR) == 2 && uChar >= 0x10000) {
+            if (pOutEnd - pOut < 2) {
+                return (size_t)(-1);
+            }
+            uChar -= 0x10000;
+            *pOut++ = static_cast<SI_WCHAR>(0xD800 + (uChar >> 10));
+            *pOut++ = static_cast<SI_WCHAR>(0xDC00 + (uChar & 0x3FF));
+        }
+        else {
+            *pOut++ = static_cast<SI_WCHAR>(uChar);
+        }
+    }
+
+    return static_cast<size_t>(pOut - a_pOut);
+}
+
+/** Convert UTF-16 (2 byte SI_WCHAR) or UTF-32 (4 byte SI_WCHAR) to UTF-8.
+    Runs of ASCII are narrowed 16 characters at a time where SSE2 is
+    available. Unpaired surrogates and invalid code points are written as
+    U+FFFD, the same as WideCharToMultiByte. The output never needs more
+    than 3 bytes for each input unit.
+
+    @param a_pIn        Wide character data, embedded NULLs are converted
+    @param a_uInLen     Length of the input in SI_WCHAR
+    @param a_pOut       Output buffer, or NULL to only count the output
+    @param a_uOutSize   Size of the output buffer in bytes
+
+    @return             Number of bytes written, or -1 cast to size_t if the
+                        output buffer is too small.
+ */
+template<class SI_WCHAR>
+size_t SI_WideToUtf8(
+    const SI_WCHAR *    a_pIn,
+    size_t              a_uInLen,
+    char *              a_pOut,
+    size_t              a_uOutSize
+    )
+{
+    const SI_WCHAR * pIn = a_pIn;
+    const SI_WCHAR * pInEnd = a_pIn + a_uInLen;
+    size_t uOut = 0;
+
+    while (pIn < pInEnd) {
+#ifdef SI_HAS_SSE2
+        // narrow 16 ASCII characters at a time
+        if (sizeof(SI_WCHAR) == 2) {
+            const __m128i vAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+            const __m128i vZero = _mm_setzero_si128();
+            while (pInEnd - pIn >= 16 && (!a_pOut || a_uOutSize - uOut >= 16)) {
+                const __m128i * pLoad = reinterpret_cast<const __m128i *>(pIn);
+                __m128i vLow  = _mm_loadu_si128(pLoad);
+                __m128i vHigh = _mm_loadu_si128(pLoad + 1);
+                __m128i vTest = _mm_and_si128(_mm_or_si128(vLow, vHigh), vAscii);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(vTest, vZero)) != 0xFFFF) {
+                    break;
+                }
+                if (a_pOut) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pOut + uOut),
+                        _mm_packus_epi16(vLow, vHigh));
+                }
+                pIn  += 16;
+                uOut += 16;
+            }
+            if (pIn == pInEnd) {
+                break;
+            }
+        }
+#endif // SI_HAS_SSE2
+
+        unsigned long uChar = static_cast<unsigned long>(*pIn++);
+        if (sizeof(SI_WCHAR) == 2) {
+            uChar &= 0xFFFF;
+            if (uChar >= 0xD800 && uChar <= 0xDBFF && pIn < pInEnd) {
+                unsigned long uNext = static_cast<unsigned long>(*pIn) & 0xFFFF;
+                if (uNext >= 0xDC00 && uNext <= 0xDFFF) {
+                    uChar = 0x10000 + ((uChar - 0xD800) << 10) + (uNext - 0xDC00);
+                    ++pIn;
+                }
+            }
+        }
+        if ((uChar >= 0xD800 && uChar <= 0xDFFF) || uChar > 0x10FFFF) {
+            uChar = 0xFFFD;
+        }
+
+        char szBytes[4];
+        size_t uBytes;
+        if (uChar < 0x80) {
+            szBytes[0] = static_cast<char>(uChar);
+            uBytes = 1;
+        }
+        else if (uChar < 0x800) {
+            szBytes[0] = static_cast<char>(0xC0 | (uChar >> 6));
+            szBytes[1] = static_cast<char>(0x80 | (uChar & 0x3F));
+            uBytes = 2;
+        }
+        else if (uChar < 0x10000) {
+            szBytes[0] = static_cast<char>(0xE0 | (uChar >> 12));
+            szBytes[1] = static_cast<char>(0x80 | ((uChar >> 6) & 0x3F));
+            szBytes[2] = static_cast<char>(0x80 | (uChar & 0x3F));
+            uBytes = 3;
+        }
+        else {
+            szBytes[0] = static_cast<char>(0xF0 | (uChar >> 18));
+            szBytes[1] = static_cast<char>(0x80 | ((uChar >> 12) & 0x3F));
+            szBytes[2] = static_cast<char>(0x80 | ((uChar >> 6) & 0x3F));
+            szBytes[3] = static_cast<char>(0x80 | (uChar & 0x3F));
+            uBytes = 4;
+        }
+
+        if (a_pOut) {
+            if (a_uOutSize - uOut < uBytes) {
+                return (size_t)(-1);
+            }
+            memcpy(a_pOut + uOut, szBytes, uBytes);
+        }
+        uOut += uBytes;
+    }
+
+    return uOut;
+}
+
 
 // ---------------------------------------------------------------------------
 //                              MAIN TEMPLATE CLASS
@@ -325,22 +692,34 @@ public:
         const SI_CHAR * pItem;
         const SI_CHAR * pComment;
         int             nOrder;
+        size_t          uHash;  //!< Hash of pItem as folded by SI_STRLESS
 
         Entry(const SI_CHAR * a_pszItem = NULL, int a_nOrder = 0)
             : pItem(a_pszItem)
             , pComment(NULL)
             , nOrder(a_nOrder)
+            , uHash(SI_STRLESS().Hash(a_pszItem))
         { }
         Entry(const SI_CHAR * a_pszItem, const SI_CHAR * a_pszComment, int a_nOrder)
             : pItem(a_pszItem)
             , pComment(a_pszComment)
             , nOrder(a_nOrder)
+            , uHash(SI_STRLESS().Hash(a_pszItem))
+        { }
+        /** Tag for entries that are never ordered by name, see m_strings */
+        struct Unhashed { };
+        Entry(const SI_CHAR * a_pszItem, Unhashed)
+            : pItem(a_pszItem)
+            , pComment(NULL)
+            , nOrder(0)
+            , uHash(0)
         { }
         Entry(const Entry & rhs) { operator=(rhs); }
         Entry & operator=(const Entry & rhs) {
             pItem    = rhs.pItem;
             pComment = rhs.pComment;
             nOrder   = rhs.nOrder;
+            uHash    = rhs.uHash;
             return *this;
         }
 
@@ -350,9 +729,15 @@ public:
         bool operator>(const Entry & rhs) const { return LoadOrder()(rhs, *this); }
 #endif
 
-        /** Strict less ordering by name of key only */
+        /** Strict less ordering by name of key only. Names are ordered by
+            their folded hash first, so the full string comparison is only
+            made for names with equal hashes.
+         */
         struct KeyOrder {
             bool operator()(const Entry & lhs, const Entry & rhs) const {
+                if (lhs.uHash != rhs.uHash) {
+                    return lhs.uHash < rhs.uHash;
+                }
                 const static SI_STRLESS isLess = SI_STRLESS();
                 return isLess(lhs.pItem, rhs.pItem);
             }
@@ -380,6 +765,21 @@ public:
     */
     typedef std::list<Entry> TNamesDepend;
 
+    /** Precomputed lookup key for a section and key name, see GetValue().
+        The names are hashed once on construction so that lookups through
+        the handle do not fold them again. The strings are not copied and
+        must remain valid for the lifetime of the handle.
+    */
+    struct KeyHandle {
+        Entry oSection;
+        Entry oKey;
+
+        KeyHandle(const SI_CHAR * a_pSection, const SI_CHAR * a_pKey)
+            : oSection(a_pSection)
+            , oKey(a_pKey)
+        { }
+    };
+
     /** interface definition for the OutputWriter object to pass to Save()
         in order to output the INI file data.
     */
@@ -489,6 +889,17 @@ public:
     /** Has any data been loaded */
     bool IsEmpty() const { return m_data.empty(); }
 
+    /** Build a flat index of all section/key pairs for read-mostly data.
+        While frozen, GetValue() and the typed getters use binary searches
+        over contiguous sorted arrays of sections and keys instead of
+        descending the section and key trees. Any modification of the data (load, set, delete or reset)
+        discards the index; call Freeze() again afterwards if required.
+     */
+    void Freeze();
+
+    /** Is the flat lookup index currently built */
+    bool IsFrozen() const { return !m_frozenSections.empty(); }
+
     /*-----------------------------------------------------------------------*/
     /** @{ @name Settings */
 
@@ -564,6 +975,26 @@ public:
 
     /** Query the status of spaces output */
     bool UsingSpaces() const { return m_bSpaces; }
+
+    /** Should Save() reuse the output of sections that have not changed?
+
+        When enabled, the text written for each section is kept after a call
+        to Save(). Later saves write the kept text for every section that has
+        not been modified since, and only serialize the sections that were
+        changed by SetValue(), Delete() or a further load. This costs the
+        memory of one copy of the saved data.
+
+        \param a_bIncremental  Keep and reuse the saved text of each section
+     */
+    void SetIncrementalSave(bool a_bIncremental = true) {
+        m_bIncrementalSave = a_bIncremental;
+        if (!a_bIncremental) {
+            m_sectionText.clear();
+        }
+    }
+
+    /** Query the status of incremental saving */
+    bool UsingIncrementalSave() const { return m_bIncrementalSave; }
     
 
     /** Should we recognise and parse quotes in single line values?
@@ -592,6 +1023,24 @@ public:
     /** Do we allow keys to exist without a value or equals sign? */
     bool GetAllowKeyOnly() const { return m_bAllowKeyOnly; }
 
+    /** Should copied strings (sections, keys and values added with SetValue
+        or loaded into an object that already holds data) be allocated from
+        chunks owned by this object instead of one allocation per string?
+        The chunks are released in bulk by Reset(). Strings removed with
+        Delete() or replaced by SetValue() are not reclaimed until then, so
+        use it for objects that are built or loaded once, not for long-lived
+        objects that are edited repeatedly. This value cannot be changed
+        after any string has been copied.
+
+        \param a_bUseArena  Allocate copied strings from the arena?
+     */
+    void SetArenaStrings(bool a_bUseArena = true) {
+        if (m_strings.empty() && !m_pArenaChunk) m_bUseArena = a_bUseArena;
+    }
+
+    /** Are copied strings allocated from the arena? */
+    bool UsingArenaStrings() const { return m_bUseArena; }
+
 
 
     /*-----------------------------------------------------------------------*/
@@ -935,6 +1384,24 @@ public:
         bool *          a_pHasMultiple = NULL
         ) const;
 
+    /** Retrieve the value for a specific key using a precomputed handle.
+        Behaves the same as GetValue() with the section and key names of
+        the handle.
+
+        @param a_oKey           Section and key to search for
+        @param a_pDefault       Value to return if the key is not found
+        @param a_pHasMultiple   Optionally receive notification of if there are
+                                multiple entries for this key.
+
+        @return a_pDefault      Key was not found in the section
+        @return other           Value of the key
+     */
+    const SI_CHAR * GetValue(
+        const KeyHandle &   a_oKey,
+        const SI_CHAR *     a_pDefault     = NULL,
+        bool *              a_pHasMultiple = NULL
+        ) const;
+
     /** Retrieve a numeric value for a specific key. If multiple keys are enabled
         (see SetMultiKey) then only the first value associated with that key
         will be returned, see GetAllValues for getting all values with multikey.
@@ -1272,12 +1739,97 @@ private:
     /** Delete a string from the copied strings buffer if necessary */
     void DeleteString(const SI_CHAR * a_pString);
 
+    /** Allocate space for a string of a_uLen characters from the arena */
+    SI_CHAR * AllocateArenaString(size_t a_uLen);
+
+    /** Release all arena chunks */
+    void ResetArena();
+
+#ifdef SI_HAS_MMAP
+    /** Load a file through a read-only memory mapping.
+
+        Writers are not shared while the file is mapped, so a program that
+        rewrites the file gets a sharing violation when opening it instead
+        of ERROR_USER_MAPPED_FILE while writing. A file that is already open
+        for writing fails to open here and is read through stdio instead.
+
+        @param a_pszFile    Path of the file to be loaded.
+        @param a_rc         Receives the load result if the file was mapped.
+
+        @return true        The file was mapped and a_rc holds the result.
+        @return false       The file could not be mapped, the caller should
+                            fall back to reading it through stdio.
+     */
+    bool LoadMappedFile(const char * a_pszFile, SI_Error & a_rc);
+#ifdef _WIN32
+    bool LoadMappedFile(const wchar_t * a_pwszFile, SI_Error & a_rc);
+    bool LoadMappedHandle(HANDLE a_hFile, SI_Error & a_rc);
+#endif // _WIN32
+#endif // SI_HAS_MMAP
+
+    /** Write the comment, name and keys of a single section */
+    bool OutputSection(
+        OutputWriter &  a_oOutput,
+        Converter &     a_oConverter,
+        const Entry &   a_oSection
+        ) const;
+
+    /** Discard the saved text of a section, called when it is modified */
+    void MarkSectionDirty(const SI_CHAR * a_pSection) {
+        if (!m_sectionText.empty()) {
+            m_sectionText.erase(a_pSection);
+        }
+    }
+
+    /** Discard the flat lookup index, called on every modification */
+    void Thaw() {
+        if (!m_frozenSections.empty()) {
+            m_frozenSections.clear();
+            m_frozenKeys.clear();
+        }
+    }
+
+    /** Find the first of the sorted frozen entries [a_pFirst, a_pLast) that
+        is not less than a_oName, in the order of Entry::KeyOrder */
+    template<class FROZEN>
+    static const FROZEN * FindFrozen(
+        const FROZEN *  a_pFirst,
+        const FROZEN *  a_pLast,
+        const Entry &   a_oName
+        )
+    {
+        const static SI_STRLESS isLess = SI_STRLESS();
+        while (a_pFirst < a_pLast) {
+            const FROZEN * pMid = a_pFirst + (a_pLast - a_pFirst) / 2;
+            if (pMid->uHash < a_oName.uHash ||
+                (pMid->uHash == a_oName.uHash && isLess(pMid->pItem, a_oName.pItem))) {
+                a_pFirst = pMid + 1;
+            }
+            else {
+                a_pLast = pMid;
+            }
+        }
+        return a_pFirst;
+    }
+
+    /** Find the first value for a section/key in the flat lookup index */
+    const SI_CHAR * FindFrozenValue(
+        const KeyHandle &   a_oKey,
+        bool *              a_pHasMultiple
+        ) const;
+
     /** Internal use of our string comparison function */
     bool IsLess(const SI_CHAR * a_pLeft, const SI_CHAR * a_pRight) const {
         const static SI_STRLESS isLess = SI_STRLESS();
         return isLess(a_pLeft, a_pRight);
     }
 
+    /** Do two names compare equal? Maps are ordered by hash first, so
+        entries that follow a name in a map may still sort before it. */
+    bool IsEqual(const SI_CHAR * a_pLeft, const SI_CHAR * a_pRight) const {
+        return !IsLess(a_pLeft, a_pRight) && !IsLess(a_pRight, a_pLeft);
+    }
+
     bool IsMultiLineTag(const SI_CHAR * a_pData) const;
     bool IsMultiLineData(const SI_CHAR * a_pData) const;
     bool IsSingleLineQuotedValue(const SI_CHAR* a_pData) const;
@@ -1289,6 +1841,16 @@ private:
         ) const;
     bool IsNewLineChar(SI_CHAR a_c) const;
 
+    /** Advance to the first NULL or newline character */
+    static SI_CHAR * SkipToLineEnd(SI_CHAR * a_pData) {
+        return SI_LineScanner<SI_CHAR>::Find(a_pData, 0);
+    }
+
+    /** Advance to the first NULL, newline or a_chDelim character */
+    static SI_CHAR * SkipToDelimiter(SI_CHAR * a_pData, SI_CHAR a_chDelim) {
+        return SI_LineScanner<SI_CHAR>::Find(a_pData, a_chDelim);
+    }
+
     bool OutputMultiLineText(
         OutputWriter &  a_oOutput,
         Converter &     a_oConverter,
@@ -1324,6 +1886,58 @@ private:
      */
     TNamesDepend m_strings;
 
+    /** Chunk of the string arena, chained to the previously filled chunk */
+    struct ArenaChunk {
+        ArenaChunk *    pPrev;
+        size_t          uSize;
+    };
+
+    /** Current (most recent) arena chunk, NULL when the arena is empty. The
+        characters of each chunk directly follow the ArenaChunk header.
+     */
+    ArenaChunk * m_pArenaChunk;
+
+    /** Number of characters used in the current arena chunk */
+    size_t m_uArenaUsed;
+
+    /** Are copied strings allocated from the arena? */
+    bool m_bUseArena;
+
+    /** Section of the flat lookup index built by Freeze(), with the range
+        of its keys in m_frozenKeys */
+    struct FrozenSection {
+        size_t          uHash;
+        const SI_CHAR * pItem;
+        size_t          uFirstKey;
+        size_t          uEndKey;
+    };
+
+    /** Key of the flat lookup index with its first value */
+    struct FrozenKey {
+        size_t          uHash;
+        const SI_CHAR * pItem;
+        const SI_CHAR * pValue;
+        bool            bHasMultiple;
+    };
+
+    /** Sections of the flat lookup index in section map order, empty
+        unless frozen */
+    std::vector<FrozenSection> m_frozenSections;
+
+    /** Keys of all frozen sections, each section's keys in key map order */
+    std::vector<FrozenKey> m_frozenKeys;
+
+    /** Should Save() reuse the text of unmodified sections? */
+    bool m_bIncrementalSave;
+
+    /** Saved text of each unmodified section, keyed by the section name
+        pointer owned by m_data. Only used with incremental saving.
+     */
+    mutable std::map<const SI_CHAR *, std::string> m_sectionText;
+
+    /** Output options used when m_sectionText was written */
+    mutable int m_nSectionTextFormat;
+
     /** Is the format of our datafile UTF-8 or MBCS? */
     bool m_bStoreIsUtf8;
 
@@ -1362,6 +1976,11 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::CSimpleIniTempl(
   , m_uDataLen(0)
   , m_pFileComment(NULL)
   , m_cEmptyString(0)
+  , m_pArenaChunk(NULL)
+  , m_uArenaUsed(0)
+  , m_bUseArena(false)
+  , m_bIncrementalSave(false)
+  , m_nSectionTextFormat(0)
   , m_bStoreIsUtf8(a_bIsUtf8)
   , m_bAllowMultiKey(a_bAllowMultiKey)
   , m_bAllowMultiLine(a_bAllowMultiLine)
@@ -1382,6 +2001,8 @@ void
 CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::Reset()
 {
     // remove all data
+    Thaw();
+    m_sectionText.clear();
     delete[] m_pData;
     m_pData = NULL;
     m_uDataLen = 0;
@@ -1398,6 +2019,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::Reset()
         }
         m_strings.erase(m_strings.begin(), m_strings.end());
     }
+    ResetArena();
 }
 
 template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
@@ -1406,6 +2028,13 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadFile(
     const char * a_pszFile
     )
 {
+#ifdef SI_HAS_MMAP
+    SI_Error rcMapped;
+    if (LoadMappedFile(a_pszFile, rcMapped)) {
+        return rcMapped;
+    }
+#endif // SI_HAS_MMAP
+
     FILE * fp = NULL;
 #if __STDC_WANT_SECURE_LIB__ && !_WIN32_WCE
     fopen_s(&fp, a_pszFile, "rb");
@@ -1428,6 +2057,13 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadFile(
     )
 {
 #ifdef _WIN32
+#ifdef SI_HAS_MMAP
+    SI_Error rcMapped;
+    if (LoadMappedFile(a_pwszFile, rcMapped)) {
+        return rcMapped;
+    }
+#endif // SI_HAS_MMAP
+
     FILE * fp = NULL;
 #if __STDC_WANT_SECURE_LIB__ && !_WIN32_WCE
     _wfopen_s(&fp, a_pwszFile, L"rb");
@@ -1446,6 +2082,136 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadFile(
 }
 #endif // SI_HAS_WIDE_FILE
 
+#ifdef SI_HAS_MMAP
+#ifdef _WIN32
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+bool
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadMappedFile(
+    const char *    a_pszFile,
+    SI_Error &      a_rc
+    )
+{
+    HANDLE hFile = CreateFileA(a_pszFile, GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool bMapped = LoadMappedHandle(hFile, a_rc);
+    CloseHandle(hFile);
+    return bMapped;
+}
+
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+bool
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadMappedFile(
+    const wchar_t * a_pwszFile,
+    SI_Error &      a_rc
+    )
+{
+    HANDLE hFile = CreateFileW(a_pwszFile, GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool bMapped = LoadMappedHandle(hFile, a_rc);
+    CloseHandle(hFile);
+    return bMapped;
+}
+
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+bool
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadMappedHandle(
+    HANDLE          a_hFile,
+    SI_Error &      a_rc
+    )
+{
+    LARGE_INTEGER liSize;
+    if (!GetFileSizeEx(a_hFile, &liSize)) {
+        return false;
+    }
+    if (liSize.QuadPart == 0) {
+        a_rc = SI_OK;
+        return true;
+    }
+
+    // check file size is within supported limits (SI_MAX_FILE_SIZE)
+    if (static_cast<unsigned long long>(liSize.QuadPart) > SI_MAX_FILE_SIZE) {
+        a_rc = SI_FILE;
+        return true;
+    }
+
+    HANDLE hMapping = CreateFileMappingW(a_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!hMapping) {
+        return false;
+    }
+    const char * pData = static_cast<const char *>(
+        MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!pData) {
+        CloseHandle(hMapping);
+        return false;
+    }
+
+    // convert the mapped data directly, LoadData() does not need it to be
+    // NULL terminated
+    a_rc = LoadData(pData, static_cast<size_t>(liSize.QuadPart));
+
+    UnmapViewOfFile(pData);
+    CloseHandle(hMapping);
+    return true;
+}
+#else // !_WIN32
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+bool
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadMappedFile(
+    const char *    a_pszFile,
+    SI_Error &      a_rc
+    )
+{
+    int fd = open(a_pszFile, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        a_rc = SI_OK;
+        return true;
+    }
+
+    // check file size is within supported limits (SI_MAX_FILE_SIZE)
+    if (static_cast<unsigned long long>(st.st_size) > SI_MAX_FILE_SIZE) {
+        close(fd);
+        a_rc = SI_FILE;
+        return true;
+    }
+
+    size_t uSize = static_cast<size_t>(st.st_size);
+    void * pMap = mmap(NULL, uSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pMap == MAP_FAILED) {
+        return false;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(pMap, uSize, MADV_SEQUENTIAL);
+#endif
+
+    // convert the mapped data directly, LoadData() does not need it to be
+    // NULL terminated
+    a_rc = LoadData(static_cast<const char *>(pMap), uSize);
+
+    munmap(pMap, uSize);
+    return true;
+}
+#endif // _WIN32
+#endif // SI_HAS_MMAP
+
 template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
 SI_Error
 CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadFile(
@@ -1543,6 +2309,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::LoadData(
     }
 
     // parse it
+    Thaw();
     const static SI_CHAR empty = 0;
     SI_CHAR * pWork = pData;
     const SI_CHAR * pSection = &empty;
@@ -1663,9 +2430,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindEntry(
             // find the end of the section name (it may contain spaces)
             // and convert it to lowercase as necessary
             a_pSection = a_pData;
-            while (*a_pData && *a_pData != ']' && !IsNewLineChar(*a_pData)) {
-                ++a_pData;
-            }
+            a_pData = SkipToDelimiter(a_pData, ']');
 
             // if it's an invalid line, just skip it
             if (*a_pData != ']') {
@@ -1682,9 +2447,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindEntry(
 
             // skip to the end of the line
             ++a_pData;  // safe as checked that it == ']' above
-            while (*a_pData && !IsNewLineChar(*a_pData)) {
-                ++a_pData;
-            }
+            a_pData = SkipToLineEnd(a_pData);
 
             a_pKey = NULL;
             a_pVal = NULL;
@@ -1693,9 +2456,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindEntry(
 
         // find the end of the key name (it may contain spaces)
         a_pKey = a_pData;
-        while (*a_pData && *a_pData != '=' && !IsNewLineChar(*a_pData)) {
-            ++a_pData;
-        }
+        a_pData = SkipToDelimiter(a_pData, '=');
         // *a_pData is null, equals, or newline
 
         // if no value and we don't allow no value, then invalid
@@ -1706,9 +2467,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindEntry(
 
         // empty keys are invalid
         if (bHaveValue && a_pKey == a_pData) {
-            while (*a_pData && !IsNewLineChar(*a_pData)) {
-                ++a_pData;
-            }
+            a_pData = SkipToLineEnd(a_pData);
             continue;
         }
 
@@ -1731,9 +2490,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindEntry(
 
             // find the end of the value which is the end of this line
             a_pVal = a_pData;
-            while (*a_pData && !IsNewLineChar(*a_pData)) {
-                ++a_pData;
-            }
+            a_pData = SkipToLineEnd(a_pData);
 
             // remove trailing spaces from the value
             pTrail = a_pData - 1;
@@ -2022,16 +2779,65 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::CopyString(
         for ( ; a_pString[uLen]; ++uLen) /*loop*/ ;
     }
     ++uLen; // NULL character
-    SI_CHAR * pCopy = new(std::nothrow) SI_CHAR[uLen];
-    if (!pCopy) {
-        return SI_NOMEM;
+    SI_CHAR * pCopy;
+    if (m_bUseArena) {
+        pCopy = AllocateArenaString(uLen);
+        if (!pCopy) {
+            return SI_NOMEM;
+        }
+    }
+    else {
+        pCopy = new(std::nothrow) SI_CHAR[uLen];
+        if (!pCopy) {
+            return SI_NOMEM;
+        }
     }
     memcpy(pCopy, a_pString, sizeof(SI_CHAR)*uLen);
-    m_strings.push_back(pCopy);
+    if (!m_bUseArena) {
+        m_strings.push_back(Entry(pCopy, typename Entry::Unhashed()));
+    }
     a_pString = pCopy;
     return SI_OK;
 }
 
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+SI_CHAR *
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::AllocateArenaString(
+    size_t a_uLen
+    )
+{
+    // start a new chunk when the current one is full, strings larger than
+    // a chunk get a chunk of their own
+    if (!m_pArenaChunk || m_pArenaChunk->uSize - m_uArenaUsed < a_uLen) {
+        size_t uSize = a_uLen > SI_ARENA_CHUNK_SIZE ? a_uLen : SI_ARENA_CHUNK_SIZE;
+        char * pBlock = new(std::nothrow) char[sizeof(ArenaChunk) + sizeof(SI_CHAR) * uSize];
+        if (!pBlock) {
+            return NULL;
+        }
+        ArenaChunk * pChunk = reinterpret_cast<ArenaChunk *>(pBlock);
+        pChunk->pPrev = m_pArenaChunk;
+        pChunk->uSize = uSize;
+        m_pArenaChunk = pChunk;
+        m_uArenaUsed = 0;
+    }
+
+    SI_CHAR * pString = reinterpret_cast<SI_CHAR *>(m_pArenaChunk + 1) + m_uArenaUsed;
+    m_uArenaUsed += a_uLen;
+    return pString;
+}
+
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+void
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::ResetArena()
+{
+    while (m_pArenaChunk) {
+        ArenaChunk * pPrev = m_pArenaChunk->pPrev;
+        delete[] reinterpret_cast<char *>(m_pArenaChunk);
+        m_pArenaChunk = pPrev;
+    }
+    m_uArenaUsed = 0;
+}
+
 template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
 SI_Error
 CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::AddEntry(
@@ -2047,6 +2853,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::AddEntry(
     bool bInserted = false;
 
     SI_ASSERT(!a_pComment || IsComment(*a_pComment));
+    Thaw();
 
     // if we are copying strings then make a copy of the comment now
     // because we will need it when we add the entry.
@@ -2077,6 +2884,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::AddEntry(
         iSection = i.first;
         bInserted = true;
     }
+    MarkSectionDirty(iSection->first.pItem);
     if (!a_pKey) {
         // section only entries are specified with pItem as NULL
         return bInserted ? SI_INSERTED : SI_UPDATED;
@@ -2092,7 +2900,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::AddEntry(
     int nLoadOrder = ++m_nOrder;
     if (iKey != keyval.end() && m_bAllowMultiKey && a_bForceReplace) {
         const SI_CHAR * pComment = NULL;
-        while (iKey != keyval.end() && !IsLess(a_pKey, iKey->first.pItem)) {
+        while (iKey != keyval.end() && IsEqual(a_pKey, iKey->first.pItem)) {
             if (iKey->first.nOrder < nLoadOrder) {
                 nLoadOrder = iKey->first.nOrder;
                 pComment   = iKey->first.pComment;
@@ -2152,18 +2960,39 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetValue(
     const SI_CHAR * a_pDefault,
     bool *          a_pHasMultiple
     ) const
+{
+    if (!a_pSection || !a_pKey) {
+        if (a_pHasMultiple) {
+            *a_pHasMultiple = false;
+        }
+        return a_pDefault;
+    }
+    return GetValue(KeyHandle(a_pSection, a_pKey), a_pDefault, a_pHasMultiple);
+}
+
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+const SI_CHAR *
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetValue(
+    const KeyHandle &   a_oKey,
+    const SI_CHAR *     a_pDefault,
+    bool *              a_pHasMultiple
+    ) const
 {
     if (a_pHasMultiple) {
         *a_pHasMultiple = false;
     }
-    if (!a_pSection || !a_pKey) {
+    if (!a_oKey.oSection.pItem || !a_oKey.oKey.pItem) {
         return a_pDefault;
     }
-    typename TSection::const_iterator iSection = m_data.find(a_pSection);
+    if (!m_frozenSections.empty()) {
+        const SI_CHAR * pValue = FindFrozenValue(a_oKey, a_pHasMultiple);
+        return pValue ? pValue : a_pDefault;
+    }
+    typename TSection::const_iterator iSection = m_data.find(a_oKey.oSection);
     if (iSection == m_data.end()) {
         return a_pDefault;
     }
-    typename TKeyVal::const_iterator iKeyVal = iSection->second.find(a_pKey);
+    typename TKeyVal::const_iterator iKeyVal = iSection->second.find(a_oKey.oKey);
     if (iKeyVal == iSection->second.end()) {
         return a_pDefault;
     }
@@ -2172,7 +3001,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetValue(
     if (m_bAllowMultiKey && a_pHasMultiple) {
         typename TKeyVal::const_iterator iTemp = iKeyVal;
         if (++iTemp != iSection->second.end()) {
-            if (!IsLess(a_pKey, iTemp->first.pItem)) {
+            if (IsEqual(a_oKey.oKey.pItem, iTemp->first.pItem)) {
                 *a_pHasMultiple = true;
             }
         }
@@ -2181,6 +3010,76 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetValue(
     return iKeyVal->second;
 }
 
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+void
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::Freeze()
+{
+    Thaw();
+
+    // the section and key maps are already sorted, so flattening them in
+    // iteration order gives sorted arrays. Only the first value of each
+    // key is stored, which is the value that GetValue() returns.
+    m_frozenSections.reserve(m_data.size());
+    typename TSection::const_iterator iSection = m_data.begin();
+    for ( ; iSection != m_data.end(); ++iSection) {
+        FrozenSection oSection;
+        oSection.uHash     = iSection->first.uHash;
+        oSection.pItem     = iSection->first.pItem;
+        oSection.uFirstKey = m_frozenKeys.size();
+
+        const TKeyVal & section = iSection->second;
+        typename TKeyVal::const_iterator iKeyVal = section.begin();
+        while (iKeyVal != section.end()) {
+            FrozenKey oKey;
+            oKey.uHash        = iKeyVal->first.uHash;
+            oKey.pItem        = iKeyVal->first.pItem;
+            oKey.pValue       = iKeyVal->second;
+            oKey.bHasMultiple = false;
+
+            // skip any further values of the same key
+            ++iKeyVal;
+            while (iKeyVal != section.end() && IsEqual(oKey.pItem, iKeyVal->first.pItem)) {
+                oKey.bHasMultiple = true;
+                ++iKeyVal;
+            }
+            m_frozenKeys.push_back(oKey);
+        }
+
+        oSection.uEndKey = m_frozenKeys.size();
+        m_frozenSections.push_back(oSection);
+    }
+}
+
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+const SI_CHAR *
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::FindFrozenValue(
+    const KeyHandle &   a_oKey,
+    bool *              a_pHasMultiple
+    ) const
+{
+    // binary search for the section, then for the key among its keys,
+    // comparing the cached hashes before any text
+    const static SI_STRLESS isLess = SI_STRLESS();
+    const FrozenSection * pSectionsEnd = m_frozenSections.data() + m_frozenSections.size();
+    const FrozenSection * pSection = FindFrozen(m_frozenSections.data(), pSectionsEnd, a_oKey.oSection);
+    if (pSection == pSectionsEnd || pSection->uHash != a_oKey.oSection.uHash ||
+        isLess(a_oKey.oSection.pItem, pSection->pItem)) {
+        return NULL;
+    }
+
+    const FrozenKey * pKeysEnd = m_frozenKeys.data() + pSection->uEndKey;
+    const FrozenKey * pKey = FindFrozen(m_frozenKeys.data() + pSection->uFirstKey, pKeysEnd, a_oKey.oKey);
+    if (pKey == pKeysEnd || pKey->uHash != a_oKey.oKey.uHash ||
+        isLess(a_oKey.oKey.pItem, pKey->pItem)) {
+        return NULL;
+    }
+
+    if (m_bAllowMultiKey && a_pHasMultiple) {
+        *a_pHasMultiple = pKey->bHasMultiple;
+    }
+    return pKey->pValue;
+}
+
 template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
 long
 CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetLongValue(
@@ -2402,7 +3301,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetAllValues(
     a_values.push_back(Entry(iKeyVal->second, iKeyVal->first.pComment, iKeyVal->first.nOrder));
     if (m_bAllowMultiKey) {
         ++iKeyVal;
-        while (iKeyVal != iSection->second.end() && !IsLess(a_pKey, iKeyVal->first.pItem)) {
+        while (iKeyVal != iSection->second.end() && IsEqual(a_pKey, iKeyVal->first.pItem)) {
             a_values.push_back(Entry(iKeyVal->second, iKeyVal->first.pComment, iKeyVal->first.nOrder));
             ++iKeyVal;
         }
@@ -2438,7 +3337,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetSectionSize(
     const SI_CHAR * pLastKey = NULL;
     typename TKeyVal::const_iterator iKeyVal = section.begin();
     for (; iKeyVal != section.end(); ++iKeyVal) {
-        if (!pLastKey || IsLess(pLastKey, iKeyVal->first.pItem)) {
+        if (!pLastKey || !IsEqual(pLastKey, iKeyVal->first.pItem)) {
             ++nCount;
             pLastKey = iKeyVal->first.pItem;
         }
@@ -2496,7 +3395,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::GetAllKeys(
     const SI_CHAR * pLastKey = NULL;
     typename TKeyVal::const_iterator iKeyVal = section.begin();
     for (; iKeyVal != section.end(); ++iKeyVal) {
-        if (!pLastKey || IsLess(pLastKey, iKeyVal->first.pItem)) {
+        if (!pLastKey || !IsEqual(pLastKey, iKeyVal->first.pItem)) {
             a_names.push_back(iKeyVal->first);
             pLastKey = iKeyVal->first.pItem;
         }
@@ -2609,106 +3508,139 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::Save(
         bNeedNewLine = true;
     }
 
+    // sections saved before are reused only if they were written with the
+    // same output options
+    if (m_bIncrementalSave) {
+        int nFormat = (m_bStoreIsUtf8 ? 1 : 0) | (m_bSpaces ? 2 : 0)
+            | (m_bParseQuotes ? 4 : 0) | (m_bAllowMultiLine ? 8 : 0)
+            | (m_bAllowKeyOnly ? 16 : 0);
+        if (nFormat != m_nSectionTextFormat) {
+            m_sectionText.clear();
+            m_nSectionTextFormat = nFormat;
+        }
+    }
+
     // iterate through our sections and output the data
     typename TNamesDepend::const_iterator iSection = oSections.begin();
     for ( ; iSection != oSections.end(); ++iSection ) {
-        // write out the comment if there is one
-        if (iSection->pComment) {
-            if (bNeedNewLine) {
-                a_oOutput.Write(SI_NEWLINE_A);
-                a_oOutput.Write(SI_NEWLINE_A);
-            }
-            if (!OutputMultiLineText(a_oOutput, convert, iSection->pComment)) {
-                return SI_FAIL;
-            }
-            bNeedNewLine = false;
-        }
-
         if (bNeedNewLine) {
             a_oOutput.Write(SI_NEWLINE_A);
             a_oOutput.Write(SI_NEWLINE_A);
-            bNeedNewLine = false;
         }
 
-        // write the section (unless there is no section name)
-        if (*iSection->pItem) {
-            if (!convert.ConvertToStore(iSection->pItem)) {
-                return SI_FAIL;
+        if (m_bIncrementalSave) {
+            // serialize the section only if it changed since the last save
+            std::string & sText = m_sectionText[iSection->pItem];
+            if (sText.empty()) {
+                StringWriter oText(sText);
+                if (!OutputSection(oText, convert, *iSection)) {
+                    m_sectionText.erase(iSection->pItem);
+                    return SI_FAIL;
+                }
             }
-            a_oOutput.Write("[");
-            a_oOutput.Write(convert.Data());
-            a_oOutput.Write("]");
-            a_oOutput.Write(SI_NEWLINE_A);
+            a_oOutput.Write(sText.c_str());
         }
+        else if (!OutputSection(a_oOutput, convert, *iSection)) {
+            return SI_FAIL;
+        }
+
+        bNeedNewLine = true;
+    }
+
+    return SI_OK;
+}
 
-        // get all of the keys sorted in load order
-        TNamesDepend oKeys;
-        GetAllKeys(iSection->pItem, oKeys);
+template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
+bool
+CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::OutputSection(
+    OutputWriter &  a_oOutput,
+    Converter &     a_oConverter,
+    const Entry &   a_oSection
+    ) const
+{
+    // write out the comment if there is one
+    if (a_oSection.pComment) {
+        if (!OutputMultiLineText(a_oOutput, a_oConverter, a_oSection.pComment)) {
+            return false;
+        }
+    }
+
+    // write the section (unless there is no section name)
+    if (*a_oSection.pItem) {
+        if (!a_oConverter.ConvertToStore(a_oSection.pItem)) {
+            return false;
+        }
+        a_oOutput.Write("[");
+        a_oOutput.Write(a_oConverter.Data());
+        a_oOutput.Write("]");
+        a_oOutput.Write(SI_NEWLINE_A);
+    }
+
+    // get all of the keys sorted in load order
+    TNamesDepend oKeys;
+    GetAllKeys(a_oSection.pItem, oKeys);
 #if defined(_MSC_VER) && _MSC_VER <= 1200
-        oKeys.sort();
+    oKeys.sort();
 #elif defined(__BORLANDC__)
-        oKeys.sort(Entry::LoadOrder());
+    oKeys.sort(Entry::LoadOrder());
 #else
-        oKeys.sort(typename Entry::LoadOrder());
+    oKeys.sort(typename Entry::LoadOrder());
 #endif
 
-        // write all keys and values
-        typename TNamesDepend::const_iterator iKey = oKeys.begin();
-        for ( ; iKey != oKeys.end(); ++iKey) {
-            // get all values for this key
-            TNamesDepend oValues;
-            GetAllValues(iSection->pItem, iKey->pItem, oValues);
-
-            typename TNamesDepend::const_iterator iValue = oValues.begin();
-            for ( ; iValue != oValues.end(); ++iValue) {
-                // write out the comment if there is one
-                if (iValue->pComment) {
-                    a_oOutput.Write(SI_NEWLINE_A);
-                    if (!OutputMultiLineText(a_oOutput, convert, iValue->pComment)) {
-                        return SI_FAIL;
-                    }
+    // write all keys and values
+    typename TNamesDepend::const_iterator iKey = oKeys.begin();
+    for ( ; iKey != oKeys.end(); ++iKey) {
+        // get all values for this key
+        TNamesDepend oValues;
+        GetAllValues(a_oSection.pItem, iKey->pItem, oValues);
+
+        typename TNamesDepend::const_iterator iValue = oValues.begin();
+        for ( ; iValue != oValues.end(); ++iValue) {
+            // write out the comment if there is one
+            if (iValue->pComment) {
+                a_oOutput.Write(SI_NEWLINE_A);
+                if (!OutputMultiLineText(a_oOutput, a_oConverter, iValue->pComment)) {
+                    return false;
                 }
+            }
 
-                // write the key
-                if (!convert.ConvertToStore(iKey->pItem)) {
-                    return SI_FAIL;
-                }
-                a_oOutput.Write(convert.Data());
+            // write the key
+            if (!a_oConverter.ConvertToStore(iKey->pItem)) {
+                return false;
+            }
+            a_oOutput.Write(a_oConverter.Data());
 
-                // write the value as long 
-                if (*iValue->pItem || !m_bAllowKeyOnly) {
-                    if (!convert.ConvertToStore(iValue->pItem)) {
-                        return SI_FAIL;
-                    }
-                    a_oOutput.Write(m_bSpaces ? " = " : "=");
-                    if (m_bParseQuotes && IsSingleLineQuotedValue(iValue->pItem)) {
-                        // the only way to preserve external whitespace on a value (i.e. before or after)
-                        // is to quote it. This is simple quoting, we don't escape quotes within the data. 
-                        a_oOutput.Write("\"");
-                        a_oOutput.Write(convert.Data());
-                        a_oOutput.Write("\"");
-                    }
-                    else if (m_bAllowMultiLine && IsMultiLineData(iValue->pItem)) {
-                        // multi-line data needs to be processed specially to ensure
-                        // that we use the correct newline format for the current system
-                        a_oOutput.Write("<<<END_OF_TEXT" SI_NEWLINE_A);
-                        if (!OutputMultiLineText(a_oOutput, convert, iValue->pItem)) {
-                            return SI_FAIL;
-                        }
-                        a_oOutput.Write("END_OF_TEXT");
-                    }
-                    else {
-                        a_oOutput.Write(convert.Data());
+            // write the value as long 
+            if (*iValue->pItem || !m_bAllowKeyOnly) {
+                if (!a_oConverter.ConvertToStore(iValue->pItem)) {
+                    return false;
+                }
+                a_oOutput.Write(m_bSpaces ? " = " : "=");
+                if (m_bParseQuotes && IsSingleLineQuotedValue(iValue->pItem)) {
+                    // the only way to preserve external whitespace on a value (i.e. before or after)
+                    // is to quote it. This is simple quoting, we don't escape quotes within the data. 
+                    a_oOutput.Write("\"");
+                    a_oOutput.Write(a_oConverter.Data());
+                    a_oOutput.Write("\"");
+                }
+                else if (m_bAllowMultiLine && IsMultiLineData(iValue->pItem)) {
+                    // multi-line data needs to be processed specially to ensure
+                    // that we use the correct newline format for the current system
+                    a_oOutput.Write("<<<END_OF_TEXT" SI_NEWLINE_A);
+                    if (!OutputMultiLineText(a_oOutput, a_oConverter, iValue->pItem)) {
+                        return false;
                     }
+                    a_oOutput.Write("END_OF_TEXT");
+                }
+                else {
+                    a_oOutput.Write(a_oConverter.Data());
                 }
-                a_oOutput.Write(SI_NEWLINE_A);
             }
+            a_oOutput.Write(SI_NEWLINE_A);
         }
-
-        bNeedNewLine = true;
     }
 
-    return SI_OK;
+    return true;
 }
 
 template<class SI_CHAR, class SI_STRLESS, class SI_CONVERTER>
@@ -2768,6 +3700,8 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::DeleteValue(
     if (iSection == m_data.end()) {
         return false;
     }
+    Thaw();
+    MarkSectionDirty(iSection->first.pItem);
 
     // remove a single key if we have a keyname
     if (a_pKey) {
@@ -2794,7 +3728,7 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::DeleteValue(
             }
         }
         while (iKeyVal != iSection->second.end()
-            && !IsLess(a_pKey, iKeyVal->first.pItem));
+            && IsEqual(a_pKey, iKeyVal->first.pItem));
 
         if(!bDeleted) {
             return false;
@@ -2830,9 +3764,12 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::DeleteString(
     const SI_CHAR * a_pString
     )
 {
-    // strings may exist either inside the data block, or they will be
-    // individually allocated and stored in m_strings. We only physically
-    // delete those stored in m_strings.
+    // strings may exist either inside the data block, in the arena, or they
+    // will be individually allocated and stored in m_strings. We only
+    // physically delete those stored in m_strings.
+    if (m_bUseArena) {
+        return;
+    }
     if (!m_pData || a_pString < m_pData || a_pString >= m_pData + m_uDataLen) {
         typename TNamesDepend::iterator i = m_strings.begin();
         for (;i != m_strings.end(); ++i) {
@@ -2878,6 +3815,14 @@ CSimpleIniTempl<SI_CHAR,SI_STRLESS,SI_CONVERTER>::DeleteString(
  */
 template<class SI_CHAR>
 struct SI_GenericCase {
+    /** FNV-1a hash, equal for all strings that compare equal */
+    size_t Hash(const SI_CHAR * pItem) const {
+        size_t uHash = static_cast<size_t>(2166136261u);
+        for ( ; pItem && *pItem; ++pItem) {
+            uHash = (uHash ^ static_cast<size_t>(*pItem)) * 16777619u;
+        }
+        return uHash;
+    }
     bool operator()(const SI_CHAR * pLeft, const SI_CHAR * pRight) const {
         long cmp;
         for ( ;*pLeft && *pRight; ++pLeft, ++pRight) {
@@ -2901,6 +3846,15 @@ struct SI_GenericNoCase {
     inline SI_CHAR locase(SI_CHAR ch) const {
         return (ch < 'A' || ch > 'Z') ? ch : (ch - 'A' + 'a');
     }
+    /** FNV-1a hash of the folded string, equal for all strings that
+        compare equal */
+    size_t Hash(const SI_CHAR * pItem) const {
+        size_t uHash = static_cast<size_t>(2166136261u);
+        for ( ; pItem && *pItem; ++pItem) {
+            uHash = (uHash ^ static_cast<size_t>(locase(*pItem))) * 16777619u;
+        }
+        return uHash;
+    }
     bool operator()(const SI_CHAR * pLeft, const SI_CHAR * pRight) const {
         long cmp;
         for ( ;*pLeft && *pRight; ++pLeft, ++pRight) {
@@ -3468,15 +4422,22 @@ public:
 #include <mbstring.h>
 template<class SI_CHAR>
 struct SI_NoCase {
+    /** FNV-1a hash of the folded string. MBCS folding is not done per
+        byte, so char strings all hash equally and are ordered by _mbsicmp
+        alone. Wide strings are hashed and compared with the same ASCII
+        fold, which does not depend on the LC_CTYPE locale of the process,
+        so entries stay ordered if another module changes it. */
+    size_t Hash(const SI_CHAR * pItem) const {
+        if (sizeof(SI_CHAR) == sizeof(char)) {
+            return 0;
+        }
+        return SI_GenericNoCase<SI_CHAR>().Hash(pItem);
+    }
     bool operator()(const SI_CHAR * pLeft, const SI_CHAR * pRight) const {
         if (sizeof(SI_CHAR) == sizeof(char)) {
             return _mbsicmp((const unsigned char *)pLeft,
                 (const unsigned char *)pRight) < 0;
         }
-        if (sizeof(SI_CHAR) == sizeof(wchar_t)) {
-            return _wcsicmp((const wchar_t *)pLeft,
-                (const wchar_t *)pRight) < 0;
-        }
         return SI_GenericNoCase<SI_CHAR>()(pLeft, pRight);
     }
 };
@@ -3524,6 +4485,12 @@ public:
     {
         SI_ASSERT(a_uInputDataLen != (size_t) -1);
 
+        // UTF-8 never needs more characters than bytes, use that as the size
+        // so that the data is only scanned once
+        if (m_uCodePage == CP_UTF8 && sizeof(SI_CHAR) == sizeof(wchar_t)) {
+            return a_uInputDataLen;
+        }
+
         int retval = MultiByteToWideChar(
             m_uCodePage, 0,
             a_pInputData, (int) a_uInputDataLen,
@@ -3550,6 +4517,11 @@ public:
         SI_CHAR *       a_pOutputData,
         size_t          a_uOutputDataSize)
     {
+        if (m_uCodePage == CP_UTF8 && sizeof(SI_CHAR) == sizeof(wchar_t)) {
+            return SI_Utf8ToWide(a_pInputData, a_uInputDataLen,
+                (wchar_t *) a_pOutputData, a_uOutputDataSize) != (size_t)(-1);
+        }
+
         int nSize = MultiByteToWideChar(
             m_uCodePage, 0,
             a_pInputData, (int) a_uInputDataLen,
@@ -3570,6 +4542,11 @@ public:
     size_t SizeToStore(
         const SI_CHAR * a_pInputData)
     {
+        // at most 3 bytes for each UTF-16 character, plus the NULL
+        if (m_uCodePage == CP_UTF8 && sizeof(SI_CHAR) == sizeof(wchar_t)) {
+            return wcslen((const wchar_t *) a_pInputData) * 3 + 1;
+        }
+
         int retval = WideCharToMultiByte(
             m_uCodePage, 0,
             (const wchar_t *) a_pInputData, -1,
@@ -3595,6 +4572,12 @@ public:
         char *          a_pOutputData,
         size_t          a_uOutputDataSize)
     {
+        if (m_uCodePage == CP_UTF8 && sizeof(SI_CHAR) == sizeof(wchar_t)) {
+            size_t uLen = wcslen((const wchar_t *) a_pInputData) + 1;
+            return SI_WideToUtf8((const wchar_t *) a_pInputData, uLen,
+                a_pOutputData, a_uOutputDataSize) != (size_t)(-1);
+        }
+
         int retval = WideCharToMultiByte(
             m_uCodePage, 0,
             (const wchar_t *) a_pInputData, -1,
@@ -0,0 +1,50 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include "BangCommand.h"
+#include <string>
+
+// Navigation events, combined into the EventMask of a coalesced action
+enum MeasureEvent : unsigned int
+{
+	EVENT_STATE_CHANGE = 1 << 0,
+	EVENT_URL_CHANGE = 1 << 1,
+	EVENT_PAGE_LOAD_START = 1 << 2,
+	EVENT_PAGE_LOADING = 1 << 3,
+	EVENT_PAGE_DOM_LOAD = 1 << 4,
+	EVENT_PAGE_FIRST_LOAD = 1 << 5,
+	EVENT_PAGE_RELOAD = 1 << 6,
+	EVENT_PAGE_LOAD_FINISH = 1 << 7
+};
+
+// Lifecycle order of coalesced actions, OnStateChangeAction last so it sees the final state
+constexpr MeasureEvent g_coalescedEventOrder[] =
+{
+	EVENT_PAGE_LOAD_START,
+	EVENT_URL_CHANGE,
+	EVENT_PAGE_LOADING,
+	EVENT_PAGE_DOM_LOAD,
+	EVENT_PAGE_FIRST_LOAD,
+	EVENT_PAGE_RELOAD,
+	EVENT_PAGE_LOAD_FINISH,
+	EVENT_STATE_CHANGE,
+};
+
+// The one bang that runs the actions of the queued events, each at most once and in
+// g_coalescedEventOrder. actionOf returns the action string of an event.
+template<class ActionOf>
+std::wstring BuildCoalescedBang(unsigned int events, ActionOf actionOf)
+{
+	std::wstring bang;
+	for (MeasureEvent event : g_coalescedEventOrder)
+	{
+		if (events & event)
+		{
+			AppendAction(bang, actionOf(event));
+		}
+	}
+	return bang;
+}
@@ -3,40 +3,13 @@
 */
 
 #include "PathUtils.h"
+#include "ScriptDecode.h"
 #include "Utils.h"
 #include "../API/RainmeterAPI.h"
+#include <wil/resource.h>
 #include <vector>
 
 // Path and URI utilities
-std::wstring NormalizeUri(const std::wstring& uri)
-{
-	const std::wstring scheme_sep = L"://";
-	auto scheme_pos = uri.find(scheme_sep);
-	if (scheme_pos == std::wstring::npos)
-		return uri;
-
-	const std::wstring scheme = uri.substr(0, scheme_pos);
-	const size_t after_scheme = scheme_pos + scheme_sep.length();
-
-	if (scheme == L"file")
-	{
-		size_t last_slash = uri.find_last_of(L'/');
-		if (last_slash != std::wstring::npos)
-		{
-			return uri.substr(0, last_slash + 1);
-		}
-		return uri;
-	}
-
-	size_t path_start = uri.find(L'/', after_scheme);
-	if (path_start == std::wstring::npos)
-	{
-		return uri + L"/";
-	}
-
-	return uri.substr(0, path_start + 1);
-}
-
 std::wstring NormalizePath(void* rm, LPCWSTR path)
 {
 	if (!path || !*path)
@@ -125,48 +98,90 @@ bool IsFilePathSyntax(LPCWSTR input)
 }
 
 // File reading utilities
-std::wstring ReadScriptFile(const std::wstring& path)
+bool GetFileStamp(const std::wstring& path, FILETIME& lastWriteTime, ULONGLONG& size)
 {
-	std::ifstream is(path, std::ios::binary);
-	if (!is) {
-		throw std::runtime_error("Failed to open file");
-	}
-
-	// Read all bytes
-	std::vector<char> bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
-	size_t n = bytes.size();
-	if (n == 0) return std::wstring();
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data))
+		return false;
 
-	const unsigned char* ub = reinterpret_cast<const unsigned char*>(bytes.data());
+	lastWriteTime = data.ftLastWriteTime;
+	size = (static_cast<ULONGLONG>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+	return true;
+}
 
-	// Detect BOMs
-	if (n >= 3 && ub[0] == 0xEFu && ub[1] == 0xBBu && ub[2] == 0xBFu) {
-		// UTF-8 with BOM -> skip BOM then convert
-		return Utf8ToWstring(reinterpret_cast<const char*>(ub + 3), static_cast<int>(n - 3));
-	}
+namespace
+{
+	// Files above this size are mapped instead of copied into a buffer
+	constexpr size_t kMapThreshold = 1024 * 1024;
 
-	if (n >= 2 && ub[0] == 0xFFu && ub[1] == 0xFEu) {
-		// UTF-16 LE with BOM
+	std::wstring DecodeScript(const unsigned char* ub, size_t n)
+	{
 		std::wstring out;
-		out.reserve((n - 2) / 2);
-		for (size_t i = 2; i + 1 < n; i += 2) {
-			wchar_t ch = static_cast<wchar_t>(ub[i] | (ub[i + 1] << 8));
-			out.push_back(ch);
+		if (!DecodeScriptBytes(ub, n, out)) {
+			throw std::runtime_error("Utf8ToWstring: conversion failed");
 		}
 		return out;
 	}
 
-	if (n >= 2 && ub[0] == 0xFEu && ub[1] == 0xFFu) {
-		// UTF-16 BE with BOM -> swap bytes
-		std::wstring out;
-		out.reserve((n - 2) / 2);
-		for (size_t i = 2; i + 1 < n; i += 2) {
-			wchar_t ch = static_cast<wchar_t>((ub[i] << 8) | ub[i + 1]);
-			out.push_back(ch);
+	std::wstring ReadScriptBytes(HANDLE file, size_t n)
+	{
+		std::string bytes(n, '\0');
+		size_t total = 0;
+		while (total < n)
+		{
+			DWORD read = 0;
+			if (!ReadFile(file, bytes.data() + total, static_cast<DWORD>(n - total), &read, nullptr)) {
+				throw std::runtime_error("Failed to read file");
+			}
+			if (read == 0) break; // Truncated while reading
+			total += read;
 		}
-		return out;
+		return DecodeScript(reinterpret_cast<const unsigned char*>(bytes.data()), total);
+	}
+
+	// Maps a large file. The view is opened without write sharing, so an editor saving
+	// the file meanwhile gets a sharing violation instead of ERROR_USER_MAPPED_FILE.
+	// Returns false when the file cannot be mapped that way.
+	bool MapScriptFile(const std::wstring& path, size_t n, std::wstring& out)
+	{
+		wil::unique_hfile file(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+		if (!file) return false;
+
+		LARGE_INTEGER fileSize = {};
+		if (!GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart != static_cast<LONGLONG>(n)) return false;
+
+		wil::unique_handle mapping(CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+		if (!mapping) return false;
+
+		wil::unique_mapview_ptr<void> view(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0));
+		if (!view) return false;
+
+		out = DecodeScript(static_cast<const unsigned char*>(view.get()), n);
+		return true;
 	}
+}
 
-	// No BOM: assume UTF-8 and convert
-	return Utf8ToWstring(reinterpret_cast<const char*>(ub), static_cast<int>(n));
+std::wstring ReadScriptFile(const std::wstring& path)
+{
+	wil::unique_hfile file(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+	if (!file) {
+		throw std::runtime_error("Failed to open file");
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart > INT_MAX) {
+		throw std::runtime_error("Failed to read file");
+	}
+
+	const size_t n = static_cast<size_t>(fileSize.QuadPart);
+	if (n == 0) return std::wstring();
+
+	// Small files are copied with one read; large ones are mapped unless someone is writing them
+	std::wstring out;
+	if (n >= kMapThreshold && MapScriptFile(path, n, out)) {
+		return out;
+	}
+	return ReadScriptBytes(file.get(), n);
 }
@@ -6,12 +6,13 @@
 
 #include <Windows.h>
 #include <string>
+#include <string_view>
 #include <fstream>
 
 // Path and URI utilities
-std::wstring NormalizeUri(const std::wstring& uri);
 std::wstring NormalizePath(void* rm, LPCWSTR path);
 bool IsFilePathSyntax(LPCWSTR input);
 
 // File reading utilities
+bool GetFileStamp(const std::wstring& path, FILETIME& lastWriteTime, ULONGLONG& size);
 std::wstring ReadScriptFile(const std::wstring& path);
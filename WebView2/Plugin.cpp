@@ -5,6 +5,11 @@
 #include "Plugin.h"
 #include "Utils.h"
 #include "PathUtils.h"
+#include "ScriptCache.h"
+#include "ScriptRegistry.h"
+#include "BangCommand.h"
+#include "ReloadOptions.h"
+#include "SettingsWriter.h"
 #include "../API/RainmeterAPI.h"
 #include <WebView2EnvironmentOptions.h>
 #include <CommCtrl.h>
@@ -18,11 +23,13 @@
 // Global COM initialization tracking
 static bool g_comInitialized = false;
 
-// Global TypeLib for COM objects
-wil::com_ptr<ITypeLib> g_typeLib;
+// Module handle, recorded in DllMain
+static HMODULE g_hModule = nullptr;
+
+// Global TypeLib for COM objects (loaded on first use, see GetTypeLib)
+static wil::com_ptr<ITypeLib> g_typeLib;
 
 // Global keyboard hook and state
-static HMODULE g_hModule = nullptr;
 HHOOK g_kbHook = nullptr;
 std::atomic<bool> g_ctrlDown{ false };
 std::atomic<int>  g_refCount(0);
@@ -30,41 +37,45 @@ static std::atomic<bool> g_hookAlive{ false };
 
 static std::mutex g_skinMapMutex;
 
-// DllMain to load TypeLib from embedded resources
+// DllMain only records the module handle, no work is done under the loader lock
 BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
 {
 	if (fdwReason == DLL_PROCESS_ATTACH)
 	{
-		// Extract TypeLib from embedded resource and load it
-		wchar_t tempPath[MAX_PATH];
-		GetTempPath(MAX_PATH, tempPath);
-		wcscat_s(tempPath, L"WebView2.tlb");
-
-		// Read embedded resource: ID = 1, Type = TYPELIB
-		HRSRC hResInfo = FindResource(hinstDLL, MAKEINTRESOURCE(1), L"TYPELIB");
-		if (hResInfo)
+		g_hModule = hinstDLL;
+		DisableThreadLibraryCalls(hinstDLL);
+	}
+	return TRUE;
+}
+
+// Load the TypeLib embedded in this DLL (ID = 1, Type = TYPELIB) directly from the module image
+wil::com_ptr<ITypeLib> GetTypeLib()
+{
+	if (!g_typeLib && g_hModule)
+	{
+		// Grow the buffer until the path fits, install paths can exceed MAX_PATH
+		std::wstring modulePath(MAX_PATH, L'\0');
+		for (;;)
 		{
-			HGLOBAL hRes = LoadResource(hinstDLL, hResInfo);
-			if (hRes)  // Check if LoadResource succeeded
+			const DWORD length = GetModuleFileNameW(g_hModule, modulePath.data(), static_cast<DWORD>(modulePath.size()));
+			if (length == 0)
+				break;
+
+			if (length < modulePath.size())
 			{
-				LPVOID memRes = LockResource(hRes);
-				DWORD sizeRes = SizeofResource(hinstDLL, hResInfo);
+				modulePath.resize(length);
+				LoadTypeLibEx(modulePath.c_str(), REGKIND_NONE, &g_typeLib);
+				break;
+			}
 
-				HANDLE hFile = CreateFile(tempPath, GENERIC_WRITE, 0, NULL,
-					CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
-				if (hFile != INVALID_HANDLE_VALUE)
-				{
-					DWORD written;
-					WriteFile(hFile, memRes, sizeRes, &written, NULL);
-					CloseHandle(hFile);
+			// Truncated, GetModuleFileNameW reports ERROR_INSUFFICIENT_BUFFER
+			if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || modulePath.size() >= 32768)
+				break;
 
-					// Load the TypeLib
-					LoadTypeLib(tempPath, &g_typeLib);
-				}
-			}
+			modulePath.resize(modulePath.size() * 2);
 		}
 	}
-	return TRUE;
+	return g_typeLib;
 }
 
 // Measure constructor
@@ -170,9 +181,14 @@ void UpdateWindowBounds(Measure* measure)
 	if (!measure || !measure->webViewController)
 		return;
 
-	measure->webViewArea = {measure->x, measure->y, measure->x + measure->width, measure->y + measure->height};
+	const RECT area = {measure->x, measure->y, measure->x + measure->width, measure->y + measure->height};
 
-	measure->webViewController->put_Bounds(measure->webViewArea);
+	// Bounds are relative to the skin, so they only change with the measure options
+	if (!EqualRect(&area, &measure->webViewArea))
+	{
+		measure->webViewArea = area;
+		measure->webViewController->put_Bounds(measure->webViewArea);
+	}
 	measure->webViewController->NotifyParentWindowPositionChanged();
 }
 
@@ -319,6 +335,19 @@ LRESULT CALLBACK SkinSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lP
 	}
 	case WM_MOVE:
 	case WM_MOVING: // Update bounds during drag so window.screenX/Y work correctly on JS.
+		// Coalesce the moves of a drag into at most one update per frame
+		if (!skinData->movePending && SetTimer(hWnd, SKIN_MOVE_TIMER_ID, SKIN_MOVE_TIMER_INTERVAL, nullptr))
+		{
+			skinData->movePending = true;
+		}
+		break;
+	case WM_TIMER:
+		if (wParam != SKIN_MOVE_TIMER_ID)
+			break;
+
+		KillTimer(hWnd, SKIN_MOVE_TIMER_ID);
+		skinData->movePending = false;
+
 		for (Measure* measure : skinData->measures)
 		{
 			if (measure && measure->initialized)
@@ -326,9 +355,14 @@ LRESULT CALLBACK SkinSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lP
 				UpdateWindowBounds(measure);
 			}
 		}
-		break;
+		return 0;
 	case WM_DESTROY:
 	case WM_NCDESTROY:
+		if (skinData->movePending)
+		{
+			KillTimer(hWnd, SKIN_MOVE_TIMER_ID);
+			skinData->movePending = false;
+		}
 		RemoveWindowSubclass(hWnd, SkinSubclassProc, uIdSubclass);
 		break;
 	}
@@ -381,14 +415,6 @@ LRESULT CALLBACK LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam)
 
 void InstallKeyboardHook()
 {
-	if (!g_hModule)
-	{
-		GetModuleHandleEx(
-			GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
-			reinterpret_cast<LPCWSTR>(&LowLevelKeyboardProc),
-			&g_hModule
-		);
-	}
 	if (!g_kbHook && g_hModule)
 	{
 		g_hookAlive.store(true, std::memory_order_release);
@@ -532,96 +558,59 @@ PLUGIN_EXPORT void Reload(void* data, void* rm, double* /*maxValue*/)
 		return;
 	}
 
-	// Read basic configuration
-	const int    newWidth = RmReadInt(rm, L"W", 800);
-	const int    newHeight = RmReadInt(rm, L"H", 600);
-	const int    newX = RmReadInt(rm, L"X", 0);
-	const int    newY = RmReadInt(rm, L"Y", 0);
-	const int	 newClickthrough = RmReadInt(rm, L"Clickthrough", 2);
-	const double newZoomFactor = RmReadFormula(rm, L"ZoomFactor", 1.0);
-	const bool	 newVisible = RmReadInt(rm, L"Hidden", 0) <= 0;
-	const bool	 newNotifications = RmReadInt(rm, L"Notifications", 0) >= 1;
-	const bool	 newNewWindow = RmReadInt(rm, L"NewWindow", 0) >= 1;
-	const bool	 newZoomControl = RmReadInt(rm, L"ZoomControl", 1) >= 1;
-	const bool	 newAssistiveFeatures = RmReadInt(rm, L"AssistiveFeatures", 1) >= 1;
-	const bool	 newHostSecurity = RmReadInt(rm, L"HostSecurity", 1) >= 1;
-	const bool	 newHostOrigin = RmReadInt(rm, L"HostOrigin", 1) >= 1;
-	const std::wstring newHostPath = RmReadString(rm, L"HostPath", L"");
-	const std::wstring newUserAgent = RmReadString(rm, L"UserAgent", L"");
-
-	// URL handling
-	std::wstring newUrl;
-	LPCWSTR urlOption = RmReadString(rm, L"Url", L"");
-
-	if (urlOption && *urlOption)
+	// With DynamicVariables=1 this runs every update. The first pass only hashes the raw
+	// option strings; while they are unchanged nothing is parsed, copied or applied.
+	const unsigned long long fingerprint = GetOptionsFingerprint(rm);
+	if (measure->hasOptionsFingerprint && fingerprint == measure->optionsFingerprint &&
+		(measure->initialized || !measure->autoStart))
 	{
-		std::wstring urlStr = urlOption;
-
-		// Protocol present - use as-is
-		if (urlStr.find(L"://") != std::wstring::npos)
-		{
-			newUrl = urlStr;
-		}
-		else
-		{
-			// Relative path - convert to absolute
-			if (urlStr[0] != L'/' && (urlStr.length() < 2 || urlStr[1] != L':'))
-			{
-				if (newHostPath.empty()) // Map to file:///
-				{
-					if (LPCWSTR absolutePath = RmPathToAbsolute(rm, urlStr.c_str()))
-					{
-						urlStr = absolutePath;
-					}
-
-					// Normalize slashes
-					for (wchar_t& ch : urlStr)
-					{
-						if (ch == L'\\') ch = L'/';
-					}
-
-					// Ensure file:///
-					if (urlStr.find(L"file:///") != 0)
-					{
-						urlStr = L"file:///" + urlStr;
-					}
-				}
-				else // Map to virtual host
-				{
-					const std::wstring protocol = newHostSecurity ? L"https://" : L"http://";
-					if (urlStr[0] != L'\\')
-					{
-						urlStr = protocol + std::wstring(measure->hostName.c_str()) + L"/" + urlStr;
-					}
-					else
-					{
-						urlStr = protocol + std::wstring(measure->hostName.c_str()) + urlStr;
-					}
-				}
-			}
-
-			newUrl = urlStr;
-		}
+		++measure->fastReloads;
+		return;
 	}
 
-	// Action strings
-	auto ReadAction = [&](LPCWSTR key) -> std::wstring
-		{
-			LPCWSTR value = RmReadString(rm, key, L"", FALSE);
-			return (value && *value) ? value : L"";
-		};
+	++measure->fullReloads;
+	measure->optionsFingerprint = fingerprint;
+	measure->hasOptionsFingerprint = true;
 
-	const std::wstring newOnWebViewLoadAction = ReadAction(L"OnWebViewLoadAction");
-	const std::wstring newOnWebViewFailAction = ReadAction(L"OnWebViewFailAction");
-	const std::wstring newOnWebViewStopAction = ReadAction(L"OnWebViewStopAction");
-	const std::wstring newOnStateChangeAction = ReadAction(L"OnStateChangeAction");
-	const std::wstring newOnUrlChangeAction = ReadAction(L"OnUrlChangeAction");
-	const std::wstring newOnPageLoadStartAction = ReadAction(L"OnPageLoadStartAction");
-	const std::wstring newOnPageLoadingAction = ReadAction(L"OnPageLoadingAction");
-	const std::wstring newOnPageDOMLoadAction = ReadAction(L"OnPageDOMLoadAction");
-	const std::wstring newOnPageLoadFinishAction = ReadAction(L"OnPageLoadFinishAction");
-	const std::wstring newOnPageFirstLoadAction = ReadAction(L"OnPageFirstLoadAction");
-	const std::wstring newOnPageReloadAction = ReadAction(L"OnPageReloadAction");
+	// Read basic configuration
+	const int    newWidth = ReadOptionInt(rm, ReloadOption::W);
+	const int    newHeight = ReadOptionInt(rm, ReloadOption::H);
+	const int    newX = ReadOptionInt(rm, ReloadOption::X);
+	const int    newY = ReadOptionInt(rm, ReloadOption::Y);
+	const int	 newClickthrough = ReadOptionInt(rm, ReloadOption::Clickthrough);
+	const double newZoomFactor = ReadOptionFormula(rm, ReloadOption::ZoomFactor);
+	const bool	 newVisible = ReadOptionInt(rm, ReloadOption::Hidden) <= 0;
+	const bool	 newNotifications = ReadOptionInt(rm, ReloadOption::Notifications) >= 1;
+	const bool	 newNewWindow = ReadOptionInt(rm, ReloadOption::NewWindow) >= 1;
+	const bool	 newZoomControl = ReadOptionInt(rm, ReloadOption::ZoomControl) >= 1;
+	const bool	 newAssistiveFeatures = ReadOptionInt(rm, ReloadOption::AssistiveFeatures) >= 1;
+	const bool	 newHostSecurity = ReadOptionInt(rm, ReloadOption::HostSecurity) >= 1;
+	const bool	 newHostOrigin = ReadOptionInt(rm, ReloadOption::HostOrigin) >= 1;
+	const std::wstring newHostPath = ReadOptionString(rm, ReloadOption::HostPath);
+	const std::wstring newUserAgent = ReadOptionString(rm, ReloadOption::UserAgent);
+	const std::wstring newBatchDelimiter = ReadOptionString(rm, ReloadOption::BatchDelimiter);
+	const bool	 newBatchMergeExecute = ReadOptionInt(rm, ReloadOption::BatchMergeExecute) >= 1;
+	const bool	 newCoalesceActions = ReadOptionInt(rm, ReloadOption::CoalesceActions) >= 1;
+	const std::wstring rawUrl = ReadOptionString(rm, ReloadOption::Url);
+
+	// URL handling, only resolved again when one of its inputs changed
+	ResolvedUrlMemo& memo = measure->resolvedUrl;
+	if (!memo.valid || memo.rawUrl != rawUrl || memo.hostPath != newHostPath ||
+		memo.hostSecurity != newHostSecurity || memo.hostName != measure->hostName)
+	{
+		memo.rawUrl = rawUrl;
+		memo.hostPath = newHostPath;
+		memo.hostSecurity = newHostSecurity;
+		memo.hostName = measure->hostName;
+		memo.resolved = ResolveUrl(memo.rawUrl, !memo.hostPath.empty(), memo.hostSecurity, memo.hostName,
+			[rm](const std::wstring& path) -> std::wstring
+			{
+				LPCWSTR absolutePath = RmPathToAbsolute(rm, path.c_str());
+				return absolutePath ? absolutePath : path;
+			});
+		memo.valid = true;
+	}
+	const std::wstring& newUrl = memo.resolved;
 
 	// Change detection
 	const bool dimensionsChanged = (newWidth != measure->width || newHeight != measure->height || newX != measure->x || newY != measure->y);
@@ -647,20 +636,23 @@ PLUGIN_EXPORT void Reload(void* data, void* rm, double* /*maxValue*/)
 	measure->hostPath = newHostPath;
 	measure->userAgent = newUserAgent;
 	measure->assistiveFeatures = newAssistiveFeatures;
+	measure->batchDelimiter = newBatchDelimiter.empty() ? L"|" : newBatchDelimiter;
+	measure->batchMergeExecute = newBatchMergeExecute;
+	measure->coalesceActions = newCoalesceActions;
 
 	// Actions
-	measure->onWebViewLoadAction = newOnWebViewLoadAction;
-	measure->onWebViewFailAction = newOnWebViewFailAction;
-	measure->onWebViewStopAction = newOnWebViewStopAction;
+	measure->onWebViewLoadAction = ReadOptionString(rm, ReloadOption::OnWebViewLoadAction);
+	measure->onWebViewFailAction = ReadOptionString(rm, ReloadOption::OnWebViewFailAction);
+	measure->onWebViewStopAction = ReadOptionString(rm, ReloadOption::OnWebViewStopAction);
 	
-	measure->onStateChangeAction = newOnStateChangeAction;
-	measure->onUrlChangeAction = newOnUrlChangeAction;
-	measure->onPageLoadStartAction = newOnPageLoadStartAction;
-	measure->onPageLoadingAction = newOnPageLoadingAction;
-	measure->onPageDOMLoadAction = newOnPageDOMLoadAction;
-	measure->onPageLoadFinishAction = newOnPageLoadFinishAction;
-	measure->onPageFirstLoadAction = newOnPageFirstLoadAction;
-	measure->onPageReloadAction = newOnPageReloadAction;
+	measure->onStateChangeAction = ReadOptionString(rm, ReloadOption::OnStateChangeAction);
+	measure->onUrlChangeAction = ReadOptionString(rm, ReloadOption::OnUrlChangeAction);
+	measure->onPageLoadStartAction = ReadOptionString(rm, ReloadOption::OnPageLoadStartAction);
+	measure->onPageLoadingAction = ReadOptionString(rm, ReloadOption::OnPageLoadingAction);
+	measure->onPageDOMLoadAction = ReadOptionString(rm, ReloadOption::OnPageDOMLoadAction);
+	measure->onPageLoadFinishAction = ReadOptionString(rm, ReloadOption::OnPageLoadFinishAction);
+	measure->onPageFirstLoadAction = ReadOptionString(rm, ReloadOption::OnPageFirstLoadAction);
+	measure->onPageReloadAction = ReadOptionString(rm, ReloadOption::OnPageReloadAction);
 
 	// Initialization
 	if (!measure->initialized && measure->autoStart && !measure->disabled)
@@ -760,6 +752,9 @@ PLUGIN_EXPORT double Update(void* data)
 {
 	Measure* measure = (Measure*)data;
 
+	// Deliver the actions queued since the last update as one bang
+	measure->FlushActions();
+
 	// Call JavaScript OnUpdate callback if WebView is initialized
 	if (measure->initialized && measure->webView)
 	{
@@ -790,56 +785,32 @@ PLUGIN_EXPORT LPCWSTR GetString(void* data)
 	return L"";
 }
 
-PLUGIN_EXPORT void ExecuteBang(void* data, LPCWSTR args)
+// Runs one parsed command, bang.param must be null-terminated
+static void ExecuteCommand(Measure* measure, const ParsedBang& bang)
 {
-	Measure* measure = (Measure*)data;
-	if (!measure)
-		return;
+	LPCWSTR param = bang.param.data();
 
-	if (measure->disabled)
+	// WebView Commands
+	switch (bang.command)
 	{
-		RmLog(measure->rm, LOG_ERROR, L"WebView2: The measure is disabled");
+	case BangCommand::WebViewStart:
+		CreateWebView2(measure);
 		return;
-	}
 
-	if (!measure->isRuntimeInstalled)
-	{
-		RmLog(measure->rm, LOG_ERROR, L"WebView2: WebView2 Runtime is not installed.");
+	case BangCommand::WebViewStop:
+		StopWebView2(measure);
 		return;
-	}
 
-	std::wstring command = args;
+	case BangCommand::WebViewRestart:
+		RestartWebView2(measure);
+		return;
 
-	// Parse command
-	size_t spacePos = command.find(L' ');
-	std::wstring action = (spacePos != std::wstring::npos) ?
-		command.substr(0, spacePos) : command;
-	std::wstring param = (spacePos != std::wstring::npos) ?
-		command.substr(spacePos + 1) : L"";
+	case BangCommand::WebViewUnknown:
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: Unknown WebView command");
+		return;
 
-	// WebView Commands
-	if (_wcsicmp(action.c_str(), L"WebView") == 0)
-	{
-		if (_wcsicmp(param.c_str(), L"Start") == 0)
-		{
-			CreateWebView2(measure);
-			return;
-		}
-		else if (_wcsicmp(param.c_str(), L"Stop") == 0)
-		{
-			StopWebView2(measure);
-			return;
-		}
-		else if (_wcsicmp(param.c_str(), L"Restart") == 0)
-		{
-			RestartWebView2(measure);
-			return;
-		}
-		else
-		{
-			RmLog(measure->rm, LOG_ERROR, L"WebView2: Unknown WebView command");
-			return;
-		}
+	default:
+		break;
 	}
 
 	if (!measure->webView)
@@ -848,76 +819,70 @@ PLUGIN_EXPORT void ExecuteBang(void* data, LPCWSTR args)
 		return;
 	}
 
-	// Navigation Commands
-	if (_wcsicmp(action.c_str(), L"Navigate") == 0)
+	switch (bang.command)
 	{
-		if (_wcsicmp(param.c_str(), L"Stop") == 0)
-		{
-			measure->webView->Stop();
-		}
-		else if (_wcsicmp(param.c_str(), L"Reload") == 0)
-		{
-			measure->webView->Reload();
-		}
-		else if (_wcsicmp(param.c_str(), L"Back") == 0)
-		{
-			measure->webView->GoBack();
-		}
-		else if (_wcsicmp(param.c_str(), L"Forward") == 0)
-		{
-			measure->webView->GoForward();
-		}
-		else if (_wcsicmp(param.c_str(), L"Home") == 0)
-		{
-			measure->webView->Navigate(measure->url.c_str());
-		}
-		else
-		{
-			// Navigate to URL
-			measure->webView->Navigate(param.c_str());
-		}
-	}
-	else if (_wcsicmp(action.c_str(), L"Open") == 0)
-	{
-		if (_wcsicmp(param.c_str(), L"DevTools") == 0)
-		{
-			measure->webView->OpenDevToolsWindow();
+	// Navigation Commands
+	case BangCommand::NavigateStop:
+		measure->webView->Stop();
+		break;
 
-		}
-		else if (_wcsicmp(param.c_str(), L"TaskManager") == 0)
-		{
-			measure->webView6->OpenTaskManagerWindow();
-		}
-		else
-		{
-			RmLog(measure->rm, LOG_ERROR, L"WebView2: Unknown Open command");
-			return;
-		}
-	}
-	else if (_wcsicmp(action.c_str(), L"Execute") == 0)
-	{
-		if (!param.empty())
+	case BangCommand::NavigateReload:
+		measure->webView->Reload();
+		break;
+
+	case BangCommand::NavigateBack:
+		measure->webView->GoBack();
+		break;
+
+	case BangCommand::NavigateForward:
+		measure->webView->GoForward();
+		break;
+
+	case BangCommand::NavigateHome:
+		measure->webView->Navigate(measure->url.c_str());
+		break;
+
+	case BangCommand::NavigateUrl:
+		measure->webView->Navigate(param);
+		break;
+
+	// Open Commands
+	case BangCommand::OpenDevTools:
+		measure->webView->OpenDevToolsWindow();
+		break;
+
+	case BangCommand::OpenTaskManager:
+		measure->webView6->OpenTaskManagerWindow();
+		break;
+
+	case BangCommand::OpenUnknown:
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: Unknown Open command");
+		break;
+
+	// Execute Commands
+	case BangCommand::Execute:
+		if (*param)
 		{
-			if (IsFilePathSyntax(param.c_str())) // Script file
+			if (IsFilePathSyntax(param)) // Script file
 			{
 				try {
 
-					std::wstring path = NormalizePath(measure->rm, param.c_str());
+					std::wstring path = NormalizePath(measure->rm, param);
 
 					if (path.empty())
 					{
 						return;
 					}
 
-					std::wstring script = ReadScriptFile(path);
+					std::shared_ptr<const std::wstring> script = GetScriptFile(path);
 
-					if (script.empty())
+					if (script->empty())
 					{
 						return;
 					}
 
 					measure->webView->ExecuteScript(
-						script.c_str(),
+						script->c_str(),
 						Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
 							[](HRESULT errorCode, LPCWSTR resultObjectAsJson) -> HRESULT
 							{
@@ -942,7 +907,7 @@ PLUGIN_EXPORT void ExecuteBang(void* data, LPCWSTR args)
 			else // Script string.
 			{
 				measure->webView->ExecuteScript(
-					param.c_str(),
+					param,
 					Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
 						[](HRESULT errorCode, LPCWSTR resultObjectAsJson) -> HRESULT
 						{
@@ -952,11 +917,229 @@ PLUGIN_EXPORT void ExecuteBang(void* data, LPCWSTR args)
 				);
 			}
 		}
+		break;
+
+	// Script Commands: Script Register name path | Script Run name [args]
+	case BangCommand::ScriptRegister:
+	case BangCommand::ScriptRun:
+	{
+		const size_t namePos = bang.param.find(L' ');
+		const std::wstring name(bang.param.substr(0, namePos));
+		const std::wstring value(namePos != std::wstring_view::npos ? bang.param.substr(namePos + 1) : std::wstring_view());
+
+		try {
+			if (bang.command == BangCommand::ScriptRegister)
+			{
+				RegisterScript(measure, name, value);
+			}
+			else
+			{
+				RunScript(measure, name, value);
+			}
+		}
+		catch (const std::exception& ex) {
+			try {
+				std::wstring msg = Utf8ToWstring(
+					ex.what(),
+					static_cast<int>(std::strlen(ex.what()))
+				);
+				RmLog(measure->rm, LOG_ERROR, msg.c_str());
+			}
+			catch (...) {
+				RmLog(measure->rm, LOG_ERROR, L"Script: Unknown error");
+			}
+		}
+		break;
 	}
-	else
+
+	case BangCommand::ScriptUnknown:
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: Unknown Script command");
+		break;
+
+	case BangCommand::Batch:
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: Batch commands cannot be nested");
+		break;
+
+	default:
+		RmLogF(measure->rm, LOG_ERROR, L"WebView2: Unknown command - %.*s", static_cast<int>(bang.action.size()), bang.action.data());
+		break;
+	}
+}
+
+// Runs the BatchDelimiter separated commands of "Batch" in order
+static void ExecuteBatch(Measure* measure, std::wstring_view list)
+{
+	std::wstring command; // Reused so each command is null-terminated
+	std::wstring mergedScript;
+
+	// Consecutive inline Execute scripts share one ExecuteScript call, each in its own block
+	auto flushScripts = [&]()
+		{
+			if (mergedScript.empty())
+				return;
+
+			if (measure->webView)
+			{
+				measure->webView->ExecuteScript(
+					mergedScript.c_str(),
+					Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+						[](HRESULT errorCode, LPCWSTR resultObjectAsJson) -> HRESULT
+						{
+							return S_OK;
+						}
+					).Get()
+				);
+			}
+			mergedScript.clear();
+		};
+
+	// Only a delimiter with spaces around it separates commands, so "a || b" in a script stays whole
+	const std::wstring_view delimiter = measure->batchDelimiter;
+	auto findDelimiter = [&](size_t from) -> size_t
+		{
+			for (size_t at = list.find(delimiter, from); at != std::wstring_view::npos; at = list.find(delimiter, at + 1))
+			{
+				const size_t after = at + delimiter.size();
+				if ((at == 0 || list[at - 1] == L' ') && (after == list.size() || list[after] == L' '))
+					return at;
+			}
+			return std::wstring_view::npos;
+		};
+
+	size_t pos = 0;
+	while (pos <= list.size())
 	{
-		RmLogF(measure->rm, LOG_ERROR, L"WebView2: Unknown command - %s", action.c_str());
+		size_t end = findDelimiter(pos);
+		if (end == std::wstring_view::npos) end = list.size();
+
+		std::wstring_view item = list.substr(pos, end - pos);
+		pos = end + delimiter.size();
+
+		// Trim the spaces around the delimiter
+		while (!item.empty() && item.front() == L' ') item.remove_prefix(1);
+		while (!item.empty() && item.back() == L' ') item.remove_suffix(1);
+		if (item.empty())
+			continue;
+
+		command.assign(item);
+		const ParsedBang bang = ParseBang(command);
+
+		if (measure->batchMergeExecute && measure->webView &&
+			bang.command == BangCommand::Execute && !bang.param.empty() && !IsFilePathSyntax(bang.param.data()))
+		{
+			mergedScript += L"{\n";
+			mergedScript += bang.param;
+			mergedScript += L"\n}\n";
+			continue;
+		}
+
+		flushScripts();
+		ExecuteCommand(measure, bang);
 	}
+
+	flushScripts();
+}
+
+PLUGIN_EXPORT void ExecuteBang(void* data, LPCWSTR args)
+{
+	Measure* measure = (Measure*)data;
+	if (!measure)
+		return;
+
+	if (measure->disabled)
+	{
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: The measure is disabled");
+		return;
+	}
+
+	if (!measure->isRuntimeInstalled)
+	{
+		RmLog(measure->rm, LOG_ERROR, L"WebView2: WebView2 Runtime is not installed.");
+		return;
+	}
+
+	// Params end with args, so they stay null-terminated
+	const ParsedBang bang = ParseBang(args ? args : L"");
+	if (bang.command == BangCommand::Batch)
+	{
+		ExecuteBatch(measure, bang.param);
+		return;
+	}
+
+	ExecuteCommand(measure, bang);
+}
+
+// Reload statistics: ReloadCount(Full), ReloadCount(Fast), or the total without arguments
+PLUGIN_EXPORT LPCWSTR ReloadCount(void* data, const int argc, const WCHAR* argv[])
+{
+	Measure* measure = (Measure*)data;
+	if (!measure)
+		return L"";
+
+	unsigned long long count = measure->fullReloads + measure->fastReloads;
+	if (argc > 0 && argv[0])
+	{
+		if (_wcsicmp(argv[0], L"Full") == 0)
+		{
+			count = measure->fullReloads;
+		}
+		else if (_wcsicmp(argv[0], L"Fast") == 0)
+		{
+			count = measure->fastReloads;
+		}
+	}
+
+	measure->buffer = std::to_wstring(count);
+	return measure->buffer.c_str();
+}
+
+// Events delivered with the last coalesced action (CoalesceActions=1)
+PLUGIN_EXPORT LPCWSTR EventMask(void* data, const int argc, const WCHAR* argv[])
+{
+	Measure* measure = (Measure*)data;
+	if (!measure)
+		return L"";
+
+	measure->buffer = std::to_wstring(measure->deliveredEvents);
+	return measure->buffer.c_str();
+}
+
+// Recent navigation events, newest first, one "time|type|httpStatus|errorStatus" line each.
+// Without arguments returns how many events were recorded.
+PLUGIN_EXPORT LPCWSTR Events(void* data, const int argc, const WCHAR* argv[])
+{
+	Measure* measure = (Measure*)data;
+	if (!measure)
+		return L"";
+
+	if (argc == 0 || !argv[0] || !*argv[0])
+	{
+		measure->buffer = std::to_wstring(measure->navigationEventCount);
+		return measure->buffer.c_str();
+	}
+
+	static const wchar_t* s_typeNames[] =
+	{
+		L"Start", L"SourceChanged", L"TitleChanged", L"ContentLoading", L"DOMLoaded", L"Completed"
+	};
+
+	const size_t capacity = measure->navigationEvents.size();
+	const size_t recorded = measure->navigationEventCount < capacity ? measure->navigationEventCount : capacity;
+	const int requested = _wtoi(argv[0]);
+	const size_t count = requested <= 0 ? 0 : (static_cast<size_t>(requested) < recorded ? static_cast<size_t>(requested) : recorded);
+
+	measure->buffer.clear();
+	wchar_t line[96];
+	for (size_t i = 1; i <= count; ++i)
+	{
+		const NavigationEvent& event = measure->navigationEvents[(measure->navigationEventCount - i) % capacity];
+		swprintf_s(line, L"%llu|%s|%d|%d", event.time, s_typeNames[static_cast<int>(event.type)], event.httpStatus, event.errorStatus);
+
+		if (i > 1) measure->buffer += L'\n';
+		measure->buffer += line;
+	}
+
+	return measure->buffer.c_str();
 }
 
 // Generic JavaScript function caller
@@ -1061,6 +1244,10 @@ PLUGIN_EXPORT void Finalize(void* data)
 	// Remove subclass and delete outside lock
 	if (toDelete)
 	{
+		if (toDelete->movePending)
+		{
+			KillTimer(toDelete->hwnd, SKIN_MOVE_TIMER_ID);
+		}
 		RemoveWindowSubclass(
 			toDelete->hwnd,
 			SkinSubclassProc,
@@ -1074,10 +1261,11 @@ PLUGIN_EXPORT void Finalize(void* data)
 
 	g_refCount--;
 
-	// Remove keyboard hook if no more measures exist
+	// Remove keyboard hook and flush pending settings if no more measures exist
 	if (g_refCount == 0)
 	{
 		RemoveKeyboardHook();
+		StopSettingsWriter();
 	}
 
 	delete measure;
@@ -7,12 +7,16 @@
 #include <Windows.h>
 #include <WebView2.h>
 #include "Ini/SimpleIni.h"
+#include "Url.h"
+#include "MeasureEvents.h"
+#include "ScriptRegistry.h"
 #include <wil/com.h>
 #include <wrl.h>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
+#include <array>
 #include <unordered_map>
 #include <unordered_set>
 #include <iomanip>
@@ -20,13 +24,36 @@
 
 using namespace Microsoft::WRL;
 
-// Global TypeLib for COM objects
-extern wil::com_ptr<ITypeLib> g_typeLib;
+// TypeLib for COM objects, loaded lazily from the embedded resource
+wil::com_ptr<ITypeLib> GetTypeLib();
 
 #define WM_APP_CTRL_CHANGED (WM_APP + 100) // Custom message for Ctrl key state change
 #define WM_APP_REGION_RMB (WM_APP + 200) // Custom message for app-region RMB
 
+#define SKIN_MOVE_TIMER_ID 0x5756 // Timer coalescing skin moves into one notification per frame
+#define SKIN_MOVE_TIMER_INTERVAL 16
+
+// Entry of the per-measure navigation event history, read with Events(n)
+enum class NavigationEventType
+{
+	Start,
+	SourceChanged,
+	TitleChanged,
+	ContentLoading,
+	DOMLoaded,
+	Completed
+};
+
+struct NavigationEvent
+{
+	ULONGLONG time = 0; // GetTickCount64
+	NavigationEventType type = NavigationEventType::Start;
+	int httpStatus = 0; // Completed only
+	int errorStatus = 0; // COREWEBVIEW2_WEB_ERROR_STATUS, Completed only
+};
+
 struct SkinSubclassData;
+struct UserSettingsSnapshot;
 
 // Measure structure containing WebView2 state
 struct Measure
@@ -44,6 +71,8 @@ struct Measure
 	std::wstring extensionsPath;
 	std::wstring url;
 	std::wstring currentUrl;
+	Url currentUrlParts; // Parsed currentUrl, views into its buffer
+	std::wstring currentOrigin; // Normalized currentUrl, allowed as frame ancestor
 	std::wstring currentTitle;
 	std::wstring hostName;
 	std::wstring hostPath;
@@ -64,6 +93,25 @@ struct Measure
 	bool assistiveFeatures = true;
 	bool hostSecurity = true;
 	bool hostOrigin = true;
+	// Url option as resolved by ResolveUrl, and the inputs it was resolved from
+	struct ResolvedUrlMemo
+	{
+		std::wstring rawUrl;
+		std::wstring hostPath;
+		std::wstring hostName;
+		bool hostSecurity = true;
+		bool valid = false;
+		std::wstring resolved;
+	} resolvedUrl;
+
+	std::wstring batchDelimiter = L"|";
+	bool batchMergeExecute = false;
+	bool coalesceActions = false;
+
+	unsigned long long optionsFingerprint = 0; // Hash of the options read by the last full Reload
+	bool hasOptionsFingerprint = false;
+	unsigned long long fullReloads = 0;
+	unsigned long long fastReloads = 0;
 
 	bool initialized = false;
 	bool isCreationInProgress = false;
@@ -86,10 +134,8 @@ struct Measure
 	std::wstring onPageLoadFinishAction;
 	std::wstring onPageReloadAction;
 
-	CSimpleIniW userSettingsFile;
+	std::shared_ptr<const UserSettingsSnapshot> userSettings; // Shared UserSettings.ini snapshot
 	CSimpleIniW extensionsFile;
-	bool userSettingsChanged = false;
-	bool extensionsChanged = false;
 
 	wil::com_ptr<ICoreWebView2Environment> webViewEnvironment;
 	wil::com_ptr<ICoreWebView2Controller> webViewController;
@@ -99,14 +145,19 @@ struct Measure
 	wil::com_ptr<ICoreWebView2_6> webView6;
 	wil::com_ptr<ICoreWebView2Settings> webViewSettings;
 	wil::com_ptr<ICoreWebView2Settings2> webViewSettings2;
-	RECT webViewArea;
+	RECT webViewArea = {};
 
 	EventRegistrationToken webMessageToken;
 
 	std::wstring buffer;  // Buffer for section variable return values
 	std::map<std::wstring, std::wstring> jsResults; // Cache for CallJS results
+	std::map<std::wstring, RegisteredScript> scripts; // Script Register entries by name
 	bool isRuntimeInstalled = false;
 	int state = -1; // Integer number to show the internal state of WebView and Navigation
+	unsigned int pendingEvents = 0; // Events waiting for the next Update when CoalesceActions=1
+	unsigned int deliveredEvents = 0; // Events of the last coalesced action, for EventMask()
+	std::array<NavigationEvent, 32> navigationEvents; // Ring buffer, newest at (navigationEventCount - 1) % size
+	size_t navigationEventCount = 0;
 	wil::unique_cotaskmem_string runtimeVersion = nullptr;
 
 	Measure();
@@ -116,6 +167,11 @@ struct Measure
 	HRESULT CreateEnvironmentHandler(HRESULT result, ICoreWebView2Environment* env);
 	HRESULT CreateControllerHandler(HRESULT result, ICoreWebView2Controller* controller);
 	void Measure::SetStateAndNotify(int newState);
+	void SetCurrentUrl(const wchar_t* newUrl);
+	void NotifyAction(unsigned int event, const std::wstring& action);
+	const std::wstring& GetEventAction(MeasureEvent event) const;
+	void RecordEvent(NavigationEventType type, int httpStatus = 0, int errorStatus = 0);
+	void FlushActions();
 	HRESULT Measure::FailWebView(HRESULT hr, const wchar_t* logMessage, bool resetCreationFlag = true);
 };
 
@@ -143,6 +199,7 @@ struct SkinSubclassData
 	HWND hwnd = nullptr;
 	int refCount = 0;
 	bool destroying = false;
+	bool movePending = false; // SKIN_MOVE_TIMER_ID is running
 
 	std::unordered_set<Measure*> measures = {};
 };
@@ -0,0 +1,110 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "ReloadOptions.h"
+#include "../API/RainmeterAPI.h"
+
+namespace
+{
+	// Numeric options keep their default in number, string options in text.
+	// Actions are read without replacing measures, as they are executed later.
+	struct ReloadOptionInfo
+	{
+		ReloadOption option;
+		const wchar_t* name;
+		double number;
+		const wchar_t* text;
+		BOOL replaceMeasures;
+	};
+
+	constexpr ReloadOptionInfo g_reloadOptions[] =
+	{
+		{ ReloadOption::W, L"W", 800, L"", TRUE },
+		{ ReloadOption::H, L"H", 600, L"", TRUE },
+		{ ReloadOption::X, L"X", 0, L"", TRUE },
+		{ ReloadOption::Y, L"Y", 0, L"", TRUE },
+		{ ReloadOption::Clickthrough, L"Clickthrough", 2, L"", TRUE },
+		{ ReloadOption::ZoomFactor, L"ZoomFactor", 1.0, L"", TRUE },
+		{ ReloadOption::Hidden, L"Hidden", 0, L"", TRUE },
+		{ ReloadOption::Notifications, L"Notifications", 0, L"", TRUE },
+		{ ReloadOption::NewWindow, L"NewWindow", 0, L"", TRUE },
+		{ ReloadOption::ZoomControl, L"ZoomControl", 1, L"", TRUE },
+		{ ReloadOption::AssistiveFeatures, L"AssistiveFeatures", 1, L"", TRUE },
+		{ ReloadOption::HostSecurity, L"HostSecurity", 1, L"", TRUE },
+		{ ReloadOption::HostOrigin, L"HostOrigin", 1, L"", TRUE },
+		{ ReloadOption::HostPath, L"HostPath", 0, L"", TRUE },
+		{ ReloadOption::UserAgent, L"UserAgent", 0, L"", TRUE },
+		{ ReloadOption::BatchDelimiter, L"BatchDelimiter", 0, L"|", FALSE },
+		{ ReloadOption::BatchMergeExecute, L"BatchMergeExecute", 0, L"", TRUE },
+		{ ReloadOption::CoalesceActions, L"CoalesceActions", 0, L"", TRUE },
+		{ ReloadOption::Url, L"Url", 0, L"", TRUE },
+		{ ReloadOption::OnWebViewLoadAction, L"OnWebViewLoadAction", 0, L"", FALSE },
+		{ ReloadOption::OnWebViewFailAction, L"OnWebViewFailAction", 0, L"", FALSE },
+		{ ReloadOption::OnWebViewStopAction, L"OnWebViewStopAction", 0, L"", FALSE },
+		{ ReloadOption::OnStateChangeAction, L"OnStateChangeAction", 0, L"", FALSE },
+		{ ReloadOption::OnUrlChangeAction, L"OnUrlChangeAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageLoadStartAction, L"OnPageLoadStartAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageLoadingAction, L"OnPageLoadingAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageDOMLoadAction, L"OnPageDOMLoadAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageLoadFinishAction, L"OnPageLoadFinishAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageFirstLoadAction, L"OnPageFirstLoadAction", 0, L"", FALSE },
+		{ ReloadOption::OnPageReloadAction, L"OnPageReloadAction", 0, L"", FALSE },
+	};
+
+	constexpr size_t kOptionCount = sizeof(g_reloadOptions) / sizeof(g_reloadOptions[0]);
+	static_assert(kOptionCount == static_cast<size_t>(ReloadOption::Count), "Every Reload option needs an entry");
+
+	constexpr bool IsInEnumOrder()
+	{
+		for (size_t i = 0; i < kOptionCount; ++i)
+		{
+			if (g_reloadOptions[i].option != static_cast<ReloadOption>(i))
+				return false;
+		}
+		return true;
+	}
+	static_assert(IsInEnumOrder(), "Reload options must be listed in enum order");
+
+	const ReloadOptionInfo& GetInfo(ReloadOption option)
+	{
+		return g_reloadOptions[static_cast<size_t>(option)];
+	}
+}
+
+unsigned long long GetOptionsFingerprint(void* rm)
+{
+	unsigned long long fingerprint = 14695981039346656037ull;
+	for (const ReloadOptionInfo& info : g_reloadOptions)
+	{
+		// The string is only valid until the next read, so it is hashed right away
+		LPCWSTR value = RmReadString(rm, info.name, info.text, info.replaceMeasures);
+		for (const wchar_t* p = value; p && *p; ++p)
+		{
+			fingerprint = (fingerprint ^ static_cast<unsigned long long>(*p)) * 1099511628211ull;
+		}
+
+		// Separator, so moving text between options changes the hash
+		fingerprint = fingerprint * 1099511628211ull;
+	}
+	return fingerprint;
+}
+
+int ReadOptionInt(void* rm, ReloadOption option)
+{
+	const ReloadOptionInfo& info = GetInfo(option);
+	return RmReadInt(rm, info.name, static_cast<int>(info.number));
+}
+
+double ReadOptionFormula(void* rm, ReloadOption option)
+{
+	const ReloadOptionInfo& info = GetInfo(option);
+	return RmReadFormula(rm, info.name, info.number);
+}
+
+std::wstring ReadOptionString(void* rm, ReloadOption option)
+{
+	const ReloadOptionInfo& info = GetInfo(option);
+	LPCWSTR value = RmReadString(rm, info.name, info.text, info.replaceMeasures);
+	return value ? value : L"";
+}
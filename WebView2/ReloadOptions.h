@@ -0,0 +1,53 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+
+// Options read by Reload
+enum class ReloadOption
+{
+	W,
+	H,
+	X,
+	Y,
+	Clickthrough,
+	ZoomFactor,
+	Hidden,
+	Notifications,
+	NewWindow,
+	ZoomControl,
+	AssistiveFeatures,
+	HostSecurity,
+	HostOrigin,
+	HostPath,
+	UserAgent,
+	BatchDelimiter,
+	BatchMergeExecute,
+	CoalesceActions,
+	Url,
+	OnWebViewLoadAction,
+	OnWebViewFailAction,
+	OnWebViewStopAction,
+	OnStateChangeAction,
+	OnUrlChangeAction,
+	OnPageLoadStartAction,
+	OnPageLoadingAction,
+	OnPageDOMLoadAction,
+	OnPageLoadFinishAction,
+	OnPageFirstLoadAction,
+	OnPageReloadAction,
+	Count
+};
+
+// FNV-1a hash of the raw strings of every Reload option. Only reads the
+// strings, so it is cheap enough to run on every update with DynamicVariables=1.
+unsigned long long GetOptionsFingerprint(void* rm);
+
+// Typed reads with the defaults of each option
+int ReadOptionInt(void* rm, ReloadOption option);
+double ReadOptionFormula(void* rm, ReloadOption option);
+std::wstring ReadOptionString(void* rm, ReloadOption option);
@@ -0,0 +1,90 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "ScriptCache.h"
+#include "PathUtils.h"
+#include "Utils.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	struct CachedScript
+	{
+		std::wstring key;
+		FILETIME lastWriteTime = {};
+		ULONGLONG size = 0;
+		std::shared_ptr<const std::wstring> script;
+	};
+
+	// Upper bound for the decoded text kept in memory, in characters
+	constexpr size_t kMaxCachedChars = 4 * 1024 * 1024;
+
+	std::mutex g_scriptMutex;
+	std::list<CachedScript> g_scripts; // Most recently used first
+	std::unordered_map<std::wstring, std::list<CachedScript>::iterator> g_scriptIndex;
+	size_t g_cachedChars = 0;
+
+	void EraseScript(std::list<CachedScript>::iterator it)
+	{
+		g_cachedChars -= it->script->size();
+		g_scriptIndex.erase(it->key);
+		g_scripts.erase(it);
+	}
+}
+
+std::shared_ptr<const std::wstring> GetScriptFile(const std::wstring& path)
+{
+	// Paths are case-insensitive
+	std::wstring key = ToLower(path);
+
+	FILETIME lastWriteTime = {};
+	ULONGLONG size = 0;
+	const bool exists = GetFileStamp(path, lastWriteTime, size);
+
+	{
+		std::lock_guard<std::mutex> lock(g_scriptMutex);
+
+		auto found = g_scriptIndex.find(key);
+		if (found != g_scriptIndex.end())
+		{
+			CachedScript& cached = *found->second;
+			if (exists && CompareFileTime(&cached.lastWriteTime, &lastWriteTime) == 0 && cached.size == size)
+			{
+				g_scripts.splice(g_scripts.begin(), g_scripts, found->second);
+				return cached.script;
+			}
+
+			EraseScript(found->second);
+		}
+	}
+
+	// Read outside the lock, ReadScriptFile reports missing files
+	auto script = std::make_shared<const std::wstring>(ReadScriptFile(path));
+	if (!exists || script->size() > kMaxCachedChars)
+	{
+		return script;
+	}
+
+	std::lock_guard<std::mutex> lock(g_scriptMutex);
+
+	// Another caller may have loaded it meanwhile
+	auto found = g_scriptIndex.find(key);
+	if (found != g_scriptIndex.end())
+	{
+		EraseScript(found->second);
+	}
+
+	while (!g_scripts.empty() && g_cachedChars + script->size() > kMaxCachedChars)
+	{
+		EraseScript(std::prev(g_scripts.end()));
+	}
+
+	g_scripts.push_front({ key, lastWriteTime, size, script });
+	g_scriptIndex.emplace(std::move(key), g_scripts.begin());
+	g_cachedChars += script->size();
+
+	return script;
+}
@@ -0,0 +1,13 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+#include <string>
+
+// Decoded script file, shared with the process-wide cache.
+// Reloaded when the file's write time or size changes; throws like ReadScriptFile.
+std::shared_ptr<const std::wstring> GetScriptFile(const std::wstring& path);
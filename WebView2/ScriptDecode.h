@@ -0,0 +1,76 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include "Ini/SimpleIni.h"
+#include <cstring>
+#include <string>
+
+// Big endian UTF-16 is byte swapped with SSE2 where the target has it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCRIPTDECODE_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+// Copies UTF-16 code units, swapping byte order for big endian input
+template<class Char>
+void CopyUtf16(const unsigned char* in, size_t count, bool bigEndian, Char* out)
+{
+	static_assert(sizeof(Char) == 2, "UTF-16 output needs 2 byte characters");
+	if (!bigEndian)
+	{
+		memcpy(out, in, count * sizeof(Char));
+		return;
+	}
+
+	size_t i = 0;
+#ifdef SCRIPTDECODE_HAS_SSE2
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = static_cast<Char>((in[i * 2] << 8) | in[i * 2 + 1]);
+	}
+}
+
+// Decodes the bytes of a script file, UTF-8 or UTF-16 by its BOM and UTF-8
+// without one. The output is sized once. Returns false if the conversion fails.
+template<class Char>
+bool DecodeScriptBytes(const unsigned char* ub, size_t n, std::basic_string<Char>& out)
+{
+	out.clear();
+
+	const bool utf16 = n >= 2 && ((ub[0] == 0xFFu && ub[1] == 0xFEu) || (ub[0] == 0xFEu && ub[1] == 0xFFu));
+	if (utf16)
+	{
+		// UTF-16 with BOM, swapping bytes for big endian
+		out.resize((n - 2) / 2);
+		CopyUtf16(ub + 2, out.size(), ub[0] == 0xFEu, &out[0]);
+		return true;
+	}
+
+	// UTF-8, skipping a BOM
+	if (n >= 3 && ub[0] == 0xEFu && ub[1] == 0xBBu && ub[2] == 0xBFu)
+	{
+		ub += 3;
+		n -= 3;
+	}
+	if (n == 0) return true;
+
+	// UTF-8 never needs more UTF-16 characters than bytes
+	out.resize(n);
+	const size_t written = SI_Utf8ToWide(reinterpret_cast<const char*>(ub), n, &out[0], out.size());
+	if (written == static_cast<size_t>(-1))
+	{
+		out.clear();
+		return false;
+	}
+	out.resize(written);
+	return true;
+}
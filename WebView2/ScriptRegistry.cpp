@@ -0,0 +1,151 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "ScriptRegistry.h"
+#include "Plugin.h"
+#include "PathUtils.h"
+#include "ScriptCache.h"
+#include "../API/RainmeterAPI.h"
+
+namespace
+{
+	void ExecuteScript(Measure* measure, const std::wstring& script)
+	{
+		measure->webView->ExecuteScript(
+			script.c_str(),
+			Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+				[](HRESULT errorCode, LPCWSTR resultObjectAsJson) -> HRESULT
+				{
+					return S_OK;
+				}
+			).Get()
+		);
+	}
+
+	// Names end up inside a JS string literal, so only allow characters safe inside it: letters, digits, '_' and '-'
+	bool IsValidScriptName(const std::wstring& name)
+	{
+		if (name.empty())
+			return false;
+
+		for (wchar_t ch : name)
+		{
+			if (!((ch >= L'a' && ch <= L'z') || (ch >= L'A' && ch <= L'Z') ||
+				(ch >= L'0' && ch <= L'9') || ch == L'_' || ch == L'-'))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Inject the file into new documents and the current one. The previous document
+	// script of entry is only removed once the new one was added.
+	bool InjectScript(Measure* measure, const std::wstring& name, RegisteredScript& entry)
+	{
+		std::shared_ptr<const std::wstring> script = GetScriptFile(entry.path);
+
+		std::wstring wrapped;
+		wrapped.reserve(script->size() + name.size() + 96);
+		wrapped += L"(window.RainmeterScripts = window.RainmeterScripts || {})[\"";
+		wrapped += name;
+		wrapped += L"\"] = function () {\n";
+		wrapped += *script;
+		wrapped += L"\n};";
+
+		const unsigned int generation = entry.generation + 1;
+		HRESULT hr = measure->webView->AddScriptToExecuteOnDocumentCreated(
+			wrapped.c_str(),
+			Callback<ICoreWebView2AddScriptToExecuteOnDocumentCreatedCompletedHandler>(
+				[measure, name, generation](HRESULT errorCode, LPCWSTR id) -> HRESULT
+				{
+					if (FAILED(errorCode) || !id)
+						return S_OK;
+
+					auto it = measure->scripts.find(name);
+					if (it != measure->scripts.end() && it->second.generation == generation && measure->webView)
+					{
+						it->second.documentScriptId = id;
+					}
+					else if (measure->webView)
+					{
+						// Registration was replaced or removed before this completed
+						measure->webView->RemoveScriptToExecuteOnDocumentCreated(id);
+					}
+					return S_OK;
+				}
+			).Get()
+		);
+
+		if (FAILED(hr))
+		{
+			RmLogF(measure->rm, LOG_ERROR, L"WebView2: Could not register script \"%s\"", name.c_str());
+			return false;
+		}
+
+		if (!entry.documentScriptId.empty())
+		{
+			measure->webView->RemoveScriptToExecuteOnDocumentCreated(entry.documentScriptId.c_str());
+			entry.documentScriptId.clear();
+		}
+		entry.generation = generation;
+
+		ExecuteScript(measure, wrapped);
+		return true;
+	}
+}
+
+bool RegisterScript(Measure* measure, const std::wstring& name, const std::wstring& path)
+{
+	if (!IsValidScriptName(name))
+	{
+		RmLogF(measure->rm, LOG_ERROR, L"WebView2: Invalid script name \"%s\"", name.c_str());
+		return false;
+	}
+
+	// Work on a copy, so a failed registration keeps the previous one
+	auto it = measure->scripts.find(name);
+	RegisteredScript entry = it != measure->scripts.end() ? it->second : RegisteredScript();
+	entry.path = NormalizePath(measure->rm, path.c_str());
+
+	if (entry.path.empty() || !GetFileStamp(entry.path, entry.lastWriteTime, entry.size))
+	{
+		RmLogF(measure->rm, LOG_ERROR, L"WebView2: Script file not found: %s", path.c_str());
+		return false;
+	}
+
+	if (!InjectScript(measure, name, entry))
+		return false;
+
+	measure->scripts[name] = std::move(entry);
+	return true;
+}
+
+void RunScript(Measure* measure, const std::wstring& name, const std::wstring& args)
+{
+	auto it = measure->scripts.find(name);
+	if (it == measure->scripts.end())
+	{
+		RmLogF(measure->rm, LOG_ERROR, L"WebView2: Script \"%s\" is not registered", name.c_str());
+		return;
+	}
+
+	// Register again when the file was edited since
+	RegisteredScript& entry = it->second;
+	FILETIME lastWriteTime = {};
+	ULONGLONG size = 0;
+	if (GetFileStamp(entry.path, lastWriteTime, size) &&
+		(CompareFileTime(&entry.lastWriteTime, &lastWriteTime) != 0 || entry.size != size))
+	{
+		RegisteredScript updated = entry;
+		updated.lastWriteTime = lastWriteTime;
+		updated.size = size;
+		if (!InjectScript(measure, name, updated))
+			return;
+
+		entry = std::move(updated);
+	}
+
+	ExecuteScript(measure, L"RainmeterScripts[\"" + name + L"\"](" + args + L");");
+}
@@ -0,0 +1,24 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+
+struct Measure;
+
+// Script file registered with "Script Register", injected once per document as
+// RainmeterScripts[name] and invoked by "Script Run"
+struct RegisteredScript
+{
+	std::wstring path;
+	FILETIME lastWriteTime = {};
+	ULONGLONG size = 0;
+	std::wstring documentScriptId; // AddScriptToExecuteOnDocumentCreated id
+	unsigned int generation = 0;    // Ignores ids from superseded registrations
+};
+
+bool RegisterScript(Measure* measure, const std::wstring& name, const std::wstring& path);
+void RunScript(Measure* measure, const std::wstring& name, const std::wstring& args);
@@ -0,0 +1,186 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "SettingsWriter.h"
+#include "PathUtils.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct IniChange
+	{
+		std::wstring section;
+		std::wstring key; // Empty key removes the whole section
+		std::wstring value;
+		bool onlyIfMissing = false;
+	};
+
+	// File content as of the last write, only touched by the writer thread
+	struct WrittenFile
+	{
+		FILETIME lastWriteTime = {};
+		ULONGLONG size = 0;
+		std::unique_ptr<CSimpleIniW> ini;
+	};
+
+	constexpr std::chrono::milliseconds kCoalesceWindow(250);
+
+	std::mutex g_writerMutex;
+	std::condition_variable g_writerCondition;
+	std::map<std::wstring, std::vector<IniChange>> g_pendingChanges;
+	std::chrono::steady_clock::time_point g_lastChange;
+	std::thread g_writerThread;
+	bool g_writerStopping = false;
+	std::map<std::wstring, WrittenFile> g_writtenFiles;
+
+	void WriteIniFile(const std::wstring& path, const std::vector<IniChange>& changes)
+	{
+		FILETIME lastWriteTime = {};
+		ULONGLONG size = 0;
+		const bool exists = GetFileStamp(path, lastWriteTime, size);
+
+		// Reuse the content from the last write unless the file was changed since,
+		// so only the sections touched by these changes are serialized again
+		WrittenFile& file = g_writtenFiles[path];
+		if (!file.ini || !exists ||
+			CompareFileTime(&file.lastWriteTime, &lastWriteTime) != 0 || file.size != size)
+		{
+			file.ini = std::make_unique<CSimpleIniW>();
+			file.ini->SetUnicode();
+			file.ini->SetIncrementalSave();
+			file.ini->LoadFile(path.c_str());
+		}
+		CSimpleIniW& ini = *file.ini;
+
+		bool changed = !exists;
+		for (const IniChange& change : changes)
+		{
+			if (change.key.empty())
+			{
+				changed |= ini.Delete(change.section.c_str(), nullptr);
+				continue;
+			}
+
+			// Unchanged values leave their section clean
+			const wchar_t* current = ini.GetValue(change.section.c_str(), change.key.c_str(), nullptr);
+			if (!current || (!change.onlyIfMissing && change.value != current))
+			{
+				ini.SetValue(change.section.c_str(), change.key.c_str(), change.value.c_str());
+				changed = true;
+			}
+		}
+
+		if (!changed)
+			return;
+
+		// Write a temporary file and swap it in, readers never see a truncated file
+		const std::wstring tempPath = path + L"." + std::to_wstring(GetCurrentProcessId()) + L".tmp";
+		if (ini.SaveFile(tempPath.c_str()) < 0 ||
+			!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ||
+			!GetFileStamp(path, file.lastWriteTime, file.size))
+		{
+			DeleteFileW(tempPath.c_str());
+			g_writtenFiles.erase(path);
+		}
+	}
+
+	void WriterThread()
+	{
+		std::unique_lock<std::mutex> lock(g_writerMutex);
+		for (;;)
+		{
+			g_writerCondition.wait(lock, [] { return g_writerStopping || !g_pendingChanges.empty(); });
+			if (g_pendingChanges.empty())
+				break;
+
+			// Keep collecting until the window passes without new changes
+			while (!g_writerStopping && std::chrono::steady_clock::now() < g_lastChange + kCoalesceWindow)
+			{
+				g_writerCondition.wait_until(lock, g_lastChange + kCoalesceWindow);
+			}
+
+			std::map<std::wstring, std::vector<IniChange>> changes;
+			changes.swap(g_pendingChanges);
+
+			lock.unlock();
+			for (const auto& file : changes)
+			{
+				WriteIniFile(file.first, file.second);
+			}
+			lock.lock();
+		}
+
+		g_writtenFiles.clear();
+	}
+
+	void QueueChange(const std::wstring& path, IniChange change)
+	{
+		std::lock_guard<std::mutex> lock(g_writerMutex);
+		g_pendingChanges[path].push_back(std::move(change));
+		g_lastChange = std::chrono::steady_clock::now();
+
+		if (!g_writerThread.joinable())
+		{
+			g_writerStopping = false;
+			g_writerThread = std::thread(WriterThread);
+		}
+		g_writerCondition.notify_all();
+	}
+}
+
+void QueueIniValue(const std::wstring& path, const wchar_t* section, const wchar_t* key, const wchar_t* value)
+{
+	if (!section || !key)
+		return;
+
+	QueueChange(path, { section, key, value ? value : L"", false });
+}
+
+void QueueIniDefaults(const std::wstring& path, const CSimpleIniW& defaults, const wchar_t* skipSection)
+{
+	// Queue in the order the defaults were added, so new files follow that order
+	CSimpleIniW::TNamesDepend sections;
+	defaults.GetAllSections(sections);
+	sections.sort(CSimpleIniW::Entry::LoadOrder());
+	for (const auto& section : sections)
+	{
+		if (skipSection && _wcsicmp(section.pItem, skipSection) == 0)
+			continue;
+
+		CSimpleIniW::TNamesDepend keys;
+		defaults.GetAllKeys(section.pItem, keys);
+		keys.sort(CSimpleIniW::Entry::LoadOrder());
+		for (const auto& key : keys)
+		{
+			QueueChange(path, { section.pItem, key.pItem, defaults.GetValue(section.pItem, key.pItem, L""), true });
+		}
+	}
+}
+
+void QueueIniDeleteSection(const std::wstring& path, const wchar_t* section)
+{
+	if (!section)
+		return;
+
+	QueueChange(path, { section, L"", L"", false });
+}
+
+void StopSettingsWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(g_writerMutex);
+		if (!g_writerThread.joinable())
+			return;
+		g_writerStopping = true;
+	}
+
+	g_writerCondition.notify_all();
+	g_writerThread.join();
+}
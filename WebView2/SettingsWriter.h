@@ -0,0 +1,19 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include "Ini/SimpleIni.h"
+
+// Background INI writer. Changes are queued from the UI thread, coalesced for a
+// short window and written once per file through a temporary file + rename.
+void QueueIniValue(const std::wstring& path, const wchar_t* section, const wchar_t* key, const wchar_t* value);
+// Queues keys of defaults that are missing from the file, skipping skipSection if given
+void QueueIniDefaults(const std::wstring& path, const CSimpleIniW& defaults, const wchar_t* skipSection = nullptr);
+void QueueIniDeleteSection(const std::wstring& path, const wchar_t* section);
+
+// Write all pending changes and stop the writer thread
+void StopSettingsWriter();
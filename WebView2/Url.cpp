@@ -0,0 +1,217 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "Url.h"
+
+namespace
+{
+	bool IsAlpha(wchar_t ch)
+	{
+		return (ch >= L'a' && ch <= L'z') || (ch >= L'A' && ch <= L'Z');
+	}
+
+	bool IsSchemeChar(wchar_t ch)
+	{
+		return IsAlpha(ch) || (ch >= L'0' && ch <= L'9') || ch == L'+' || ch == L'-' || ch == L'.';
+	}
+
+	// Schemes and host names are case-insensitive ASCII
+	bool EqualsNoCase(std::wstring_view a, std::wstring_view b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			wchar_t ca = a[i], cb = b[i];
+			if (ca >= L'A' && ca <= L'Z') ca += L'a' - L'A';
+			if (cb >= L'A' && cb <= L'Z') cb += L'a' - L'A';
+			if (ca != cb)
+				return false;
+		}
+		return true;
+	}
+}
+
+bool Url::IsScheme(std::wstring_view name) const
+{
+	return EqualsNoCase(scheme, name);
+}
+
+bool Url::IsHost(std::wstring_view name) const
+{
+	return hasAuthority && EqualsNoCase(host, name);
+}
+
+std::wstring_view Url::Origin() const
+{
+	if (!hasAuthority)
+		return href;
+
+	return href.substr(0, Offset(authority) + authority.size());
+}
+
+std::wstring_view Url::SchemeSpecificPart() const
+{
+	return scheme.empty() ? href : href.substr(scheme.size() + 1);
+}
+
+Url ParseUrl(std::wstring_view href)
+{
+	Url url;
+	url.href = href;
+	size_t pos = 0;
+
+	// scheme = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ) ":"
+	if (!href.empty() && IsAlpha(href[0]))
+	{
+		size_t i = 1;
+		while (i < href.size() && IsSchemeChar(href[i])) ++i;
+
+		if (i < href.size() && href[i] == L':')
+		{
+			url.scheme = href.substr(0, i);
+			pos = i + 1;
+		}
+	}
+
+	// "//" authority, ends at the first '/', '?' or '#'
+	if (href.size() - pos >= 2 && href[pos] == L'/' && href[pos + 1] == L'/')
+	{
+		url.hasAuthority = true;
+		pos += 2;
+
+		size_t end = href.find_first_of(L"/?#", pos);
+		if (end == std::wstring_view::npos) end = href.size();
+
+		url.authority = href.substr(pos, end - pos);
+		pos = end;
+
+		std::wstring_view hostPort = url.authority;
+		const size_t at = hostPort.rfind(L'@');
+		if (at != std::wstring_view::npos)
+		{
+			url.userInfo = hostPort.substr(0, at);
+			hostPort.remove_prefix(at + 1);
+		}
+
+		// Colons inside an IP literal are not port separators
+		size_t colon = std::wstring_view::npos;
+		if (!hostPort.empty() && hostPort[0] == L'[')
+		{
+			const size_t close = hostPort.find(L']');
+			if (close != std::wstring_view::npos && close + 1 < hostPort.size() && hostPort[close + 1] == L':')
+			{
+				colon = close + 1;
+			}
+		}
+		else
+		{
+			colon = hostPort.rfind(L':');
+		}
+
+		if (colon != std::wstring_view::npos)
+		{
+			url.port = hostPort.substr(colon + 1);
+			hostPort = hostPort.substr(0, colon);
+		}
+		url.host = hostPort;
+	}
+
+	size_t end = href.find_first_of(L"?#", pos);
+	if (end == std::wstring_view::npos) end = href.size();
+
+	url.path = href.substr(pos, end - pos);
+	pos = end;
+
+	if (pos < href.size() && href[pos] == L'?')
+	{
+		end = href.find(L'#', pos + 1);
+		if (end == std::wstring_view::npos) end = href.size();
+
+		url.query = href.substr(pos + 1, end - pos - 1);
+		pos = end;
+	}
+
+	if (pos < href.size())
+	{
+		url.fragment = href.substr(pos + 1);
+	}
+
+	return url;
+}
+
+void NormalizeUri(const Url& url, std::wstring& origin)
+{
+	if (!url.hasAuthority)
+	{
+		// Nested URL, keep the prefix and the origin of the inner URL
+		const Url inner = ParseUrl(url.SchemeSpecificPart());
+		if (!url.scheme.empty() && inner.hasAuthority)
+		{
+			origin.assign(url.href.substr(0, url.Offset(inner.authority) + inner.authority.size()));
+			origin.push_back(L'/');
+			return;
+		}
+
+		origin.assign(url.href);
+		return;
+	}
+
+	if (url.IsScheme(L"file"))
+	{
+		// Directory of the document
+		const size_t last_slash = url.path.rfind(L'/');
+		const size_t end = url.Offset(url.path) + (last_slash == std::wstring_view::npos ? 0 : last_slash + 1);
+		origin.assign(url.href.substr(0, end));
+		return;
+	}
+
+	origin.assign(url.Origin());
+	origin.push_back(L'/');
+}
+
+void NormalizeUri(std::wstring_view uri, std::wstring& origin)
+{
+	NormalizeUri(ParseUrl(uri), origin);
+}
+
+std::wstring ResolveUrl(std::wstring_view url, bool hasHostPath, bool hostSecurity, std::wstring_view hostName,
+	const std::function<std::wstring(const std::wstring&)>& toAbsolute)
+{
+	if (url.empty())
+		return {};
+
+	// Protocol present, or absolute path - use as-is
+	if (url.find(L"://") != std::wstring_view::npos || url[0] == L'/' || (url.length() >= 2 && url[1] == L':'))
+		return std::wstring(url);
+
+	if (!hasHostPath) // Map to file:///
+	{
+		std::wstring path = toAbsolute(std::wstring(url));
+
+		// Normalize slashes
+		for (wchar_t& ch : path)
+		{
+			if (ch == L'\\') ch = L'/';
+		}
+
+		// Ensure file:///
+		if (path.compare(0, 8, L"file:///") == 0)
+			return path;
+
+		return L"file:///" + path;
+	}
+
+	// Map to virtual host
+	std::wstring result = hostSecurity ? L"https://" : L"http://";
+	result.reserve(result.size() + hostName.size() + 1 + url.size());
+	result += hostName;
+	if (url[0] != L'\\')
+	{
+		result += L'/';
+	}
+	result += url;
+	return result;
+}
@@ -0,0 +1,52 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+// RFC 3986 URL components, as views into the parsed string
+struct Url
+{
+	std::wstring_view href;
+	std::wstring_view scheme;    // Empty for relative references
+	std::wstring_view authority; // [userinfo@]host[:port]
+	std::wstring_view userInfo;
+	std::wstring_view host;      // IP literals keep their brackets
+	std::wstring_view port;
+	std::wstring_view path;
+	std::wstring_view query;     // Without '?'
+	std::wstring_view fragment;  // Without '#'
+	bool hasAuthority = false;
+
+	bool IsScheme(std::wstring_view name) const;
+	bool IsHost(std::wstring_view name) const;
+
+	// scheme://authority, or href when there is no authority
+	std::wstring_view Origin() const;
+
+	// Everything after "scheme:", e.g. the target of a view-source: URL
+	std::wstring_view SchemeSpecificPart() const;
+
+	// Offset of a component within href
+	size_t Offset(std::wstring_view part) const { return static_cast<size_t>(part.data() - href.data()); }
+};
+
+// Splits href without copying; the result is only valid while href is alive
+Url ParseUrl(std::wstring_view href);
+
+// Origin used to match frames, written into origin to reuse its buffer:
+// scheme://authority/ for URLs with an authority, the document directory for
+// file URLs, the prefix and inner origin of nested URLs such as
+// view-source:https://host/, and href otherwise
+void NormalizeUri(const Url& url, std::wstring& origin);
+void NormalizeUri(std::wstring_view uri, std::wstring& origin);
+
+// Resolves the Url option. Anything containing "://" and absolute paths are
+// kept, relative paths map to file:/// through toAbsolute, or to the virtual
+// host when there is a HostPath.
+std::wstring ResolveUrl(std::wstring_view url, bool hasHostPath, bool hostSecurity, std::wstring_view hostName,
+	const std::function<std::wstring(const std::wstring&)>& toAbsolute);
@@ -0,0 +1,103 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#include "UserSettings.h"
+#include "PathUtils.h"
+#include "Utils.h"
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	struct SettingsSnapshot
+	{
+		bool exists = false;
+		FILETIME lastWriteTime = {};
+		ULONGLONG size = 0;
+		std::shared_ptr<const UserSettingsSnapshot> settings;
+	};
+
+	std::mutex g_settingsMutex;
+	std::map<std::wstring, SettingsSnapshot> g_settingsCache;
+
+	// Schema keys, folded and hashed once instead of on every snapshot
+	const std::vector<CSimpleIniW::KeyHandle>& GetSchemaKeys()
+	{
+		static const std::vector<CSimpleIniW::KeyHandle> keys = []()
+			{
+				std::vector<CSimpleIniW::KeyHandle> result;
+				result.reserve(std::size(g_userSettingsSchema));
+				for (const UserSettingDefinition& setting : g_userSettingsSchema)
+				{
+					result.emplace_back(setting.section, setting.key);
+				}
+				return result;
+			}();
+		return keys;
+	}
+
+	// Load every schema key in one pass, collecting the missing ones with their defaults
+	void LoadSchema(const CSimpleIniW& ini, UserSettingsSnapshot& snapshot)
+	{
+		const std::vector<CSimpleIniW::KeyHandle>& keys = GetSchemaKeys();
+
+		// Built once per snapshot and never edited, so its strings can share the arena
+		snapshot.missingDefaults.SetUnicode();
+		snapshot.missingDefaults.SetArenaStrings();
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			const UserSettingDefinition& setting = g_userSettingsSchema[i];
+			const wchar_t* value = ini.GetValue(keys[i], nullptr);
+			if (!value)
+			{
+				snapshot.missingDefaults.SetValue(setting.section, setting.key, setting.defaultValue);
+				value = setting.defaultValue;
+			}
+
+			if (setting.boolValue)
+			{
+				snapshot.values.*setting.boolValue = ParseBool(value);
+			}
+			else
+			{
+				snapshot.values.*setting.stringValue = value;
+			}
+		}
+	}
+}
+
+std::shared_ptr<const UserSettingsSnapshot> GetUserSettings(const std::wstring& path)
+{
+	FILETIME lastWriteTime = {};
+	ULONGLONG size = 0;
+	const bool exists = GetFileStamp(path, lastWriteTime, size);
+
+	std::lock_guard<std::mutex> lock(g_settingsMutex);
+
+	// Reuse the cached snapshot while the file is unchanged
+	SettingsSnapshot& snapshot = g_settingsCache[path];
+	if (snapshot.settings && snapshot.exists == exists &&
+		(!exists || (CompareFileTime(&snapshot.lastWriteTime, &lastWriteTime) == 0 && snapshot.size == size)))
+	{
+		return snapshot.settings;
+	}
+
+	CSimpleIniW ini;
+	ini.SetUnicode();
+	if (exists)
+	{
+		ini.LoadFile(path.c_str());
+	}
+
+	auto settings = std::make_shared<UserSettingsSnapshot>();
+	LoadSchema(ini, *settings);
+
+	snapshot.exists = exists;
+	snapshot.lastWriteTime = lastWriteTime;
+	snapshot.size = size;
+	snapshot.settings = settings;
+	return snapshot.settings;
+}
@@ -0,0 +1,90 @@
+/*
+** Copyright (C) 2025 nstechbytes. All rights reserved.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+#include <string>
+#include "Ini/SimpleIni.h"
+
+// Typed UserSettings.ini values
+struct UserSettings
+{
+	// [Environment]
+	bool fluentOverlayScrollBars;
+	bool trackingPrevention;
+	bool extensions;
+	std::wstring browserLocale;
+	std::wstring browserArguments;
+
+	// [Controller]
+	std::wstring scriptLocale;
+	bool privateMode;
+
+	// [Core]
+	bool statusBar;
+	bool pinchZoom;
+	bool swipeNavigation;
+	bool smartScreen;
+
+	// [Profile]
+	std::wstring downloadsFolderPath;
+	std::wstring colorScheme;
+	bool passwordAutoSave;
+	bool generalAutoFill;
+};
+
+// One UserSettings.ini key and the UserSettings member it is loaded into.
+// Exactly one of boolValue and stringValue is set.
+struct UserSettingDefinition
+{
+	const wchar_t* section;
+	const wchar_t* key;
+	bool UserSettings::* boolValue;
+	std::wstring UserSettings::* stringValue;
+	const wchar_t* defaultValue;
+};
+
+constexpr UserSettingDefinition BoolSetting(const wchar_t* section, const wchar_t* key, bool UserSettings::* value, bool defaultValue)
+{
+	return { section, key, value, nullptr, defaultValue ? L"true" : L"false" };
+}
+
+constexpr UserSettingDefinition StringSetting(const wchar_t* section, const wchar_t* key, std::wstring UserSettings::* value, const wchar_t* defaultValue)
+{
+	return { section, key, nullptr, value, defaultValue };
+}
+
+// UserSettings.ini schema, in the order keys are written to a new file
+constexpr UserSettingDefinition g_userSettingsSchema[] =
+{
+	BoolSetting(L"Environment", L"FluentOverlayScrollBars", &UserSettings::fluentOverlayScrollBars, true),
+	BoolSetting(L"Environment", L"TrackingPrevention", &UserSettings::trackingPrevention, true),
+	BoolSetting(L"Environment", L"Extensions", &UserSettings::extensions, false),
+	StringSetting(L"Environment", L"BrowserLocale", &UserSettings::browserLocale, L"system"),
+	// Available browser flags: https://learn.microsoft.com/en-us/microsoft-edge/webview2/concepts/webview-features-flags?tabs=win32cpp#available-webview2-browser-flags
+	StringSetting(L"Environment", L"BrowserArguments", &UserSettings::browserArguments, L"--allow-file-access-from-files"),
+	StringSetting(L"Controller", L"ScriptLocale", &UserSettings::scriptLocale, L"system"),
+	BoolSetting(L"Controller", L"PrivateMode", &UserSettings::privateMode, false),
+	BoolSetting(L"Core", L"StatusBar", &UserSettings::statusBar, true),
+	BoolSetting(L"Core", L"PinchZoom", &UserSettings::pinchZoom, true),
+	BoolSetting(L"Core", L"SwipeNavigation", &UserSettings::swipeNavigation, true),
+	BoolSetting(L"Core", L"SmartScreen", &UserSettings::smartScreen, true),
+	StringSetting(L"Profile", L"DownloadsFolderPath", &UserSettings::downloadsFolderPath, L""),
+	StringSetting(L"Profile", L"ColorScheme", &UserSettings::colorScheme, L"system"),
+	BoolSetting(L"Profile", L"PasswordAutoSave", &UserSettings::passwordAutoSave, false),
+	BoolSetting(L"Profile", L"GeneralAutoFill", &UserSettings::generalAutoFill, true),
+};
+
+// Parsed UserSettings.ini file
+struct UserSettingsSnapshot
+{
+	UserSettings values;
+	CSimpleIniW missingDefaults; // Schema keys absent from the file, with their default values
+};
+
+// Shared UserSettings.ini snapshot. The file is parsed once and reused by every
+// measure until its last write time or size changes.
+std::shared_ptr<const UserSettingsSnapshot> GetUserSettings(const std::wstring& path);
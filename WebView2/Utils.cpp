@@ -20,18 +20,14 @@ std::wstring Utf8ToWstring(const char* data, int len)
 {
 	if (len <= 0) return std::wstring();
 
-	// First call to get required buffer size
-	int required = MultiByteToWideChar(CP_UTF8, 0, data, len, nullptr, 0);
-	if (required == 0) {
-		throw std::runtime_error("Utf8ToWstring: MultiByteToWideChar failed (size query)");
-	}
-
+	// UTF-8 never needs more UTF-16 characters than bytes, so convert in one pass
 	std::wstring out;
-	out.resize(required);
-	int res = MultiByteToWideChar(CP_UTF8, 0, data, len, &out[0], required);
-	if (res == 0) {
-		throw std::runtime_error("Utf8ToWstring: MultiByteToWideChar failed (conversion)");
+	out.resize(static_cast<size_t>(len));
+	const size_t written = SI_Utf8ToWide(data, static_cast<size_t>(len), &out[0], out.size());
+	if (written == static_cast<size_t>(-1)) {
+		throw std::runtime_error("Utf8ToWstring: conversion failed");
 	}
+	out.resize(written);
 	return out;
 }
 
@@ -46,31 +42,23 @@ bool ParseBool(const wchar_t* value)
 		_wcsicmp(value, L"on") == 0;
 }
 
-bool GetIniBool(CSimpleIniW& ini, bool& dirty, const wchar_t* section, const wchar_t* key, bool def)
+bool GetIniBool(const CSimpleIniW& ini, CSimpleIniW& defaults, const wchar_t* section, const wchar_t* key, bool def)
 {
 	const wchar_t* value = ini.GetValue(section, key, nullptr);
 	if (!value)
 	{
-		ini.SetValue(section, key, def ? L"true" : L"false");
-		dirty = true;
+		defaults.SetValue(section, key, def ? L"true" : L"false");
 		return def;
 	}
 	return ParseBool(value);
 }
 
-std::wstring GetIniString(CSimpleIniW& ini, bool& dirty, const wchar_t* section, const wchar_t* key, const wchar_t* def, bool forceDefault)
+std::wstring GetIniString(const CSimpleIniW& ini, CSimpleIniW& defaults, const wchar_t* section, const wchar_t* key, const wchar_t* def)
 {
 	const wchar_t* value = ini.GetValue(section, key, nullptr);
 	if (!value)
 	{
-		ini.SetValue(section, key, def);
-		dirty = true;
-		return def;
-	}
-	if (forceDefault && std::wcscmp(value, def) != 0)
-	{
-		ini.SetValue(section, key, def);
-		dirty = true;
+		defaults.SetValue(section, key, def);
 		return def;
 	}
 	return value;
@@ -14,5 +14,7 @@ std::wstring Utf8ToWstring(const char* data, int len);
 
 // INI file utilities
 bool ParseBool(const wchar_t* value);
-bool GetIniBool(CSimpleIniW& ini, bool& dirty, const wchar_t* section, const wchar_t* key, bool def);
-std::wstring GetIniString(CSimpleIniW& ini, bool& dirty, const wchar_t* section, const wchar_t* key, const wchar_t* def, bool forceDefault = false);
+
+// Missing keys are recorded in 'defaults' instead of modifying 'ini'
+bool GetIniBool(const CSimpleIniW& ini, CSimpleIniW& defaults, const wchar_t* section, const wchar_t* key, bool def);
+std::wstring GetIniString(const CSimpleIniW& ini, CSimpleIniW& defaults, const wchar_t* section, const wchar_t* key, const wchar_t* def);
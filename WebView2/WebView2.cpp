@@ -4,6 +4,8 @@
 
 #include "Plugin.h"
 #include "Utils.h"
+#include "UserSettings.h"
+#include "SettingsWriter.h"
 #include "PathUtils.h"
 #include "Extension.h"
 #include "HostObjectRmAPI.h"
@@ -35,18 +37,16 @@ void CreateWebView2(Measure* measure)
 
 	measure->isCreationInProgress = true;
 
-	// Load or create UserSettings.ini
-	measure->userSettingsFile.SetUnicode();
-	measure->userSettingsFile.LoadFile(measure->configPath.c_str());
-	measure->userSettingsChanged = false;
+	// Load or create UserSettings.ini, missing keys are written back once the controller is ready
+	measure->userSettings = GetUserSettings(measure->configPath);
 
 	// Read options from UserSettings.ini
-	bool fluentBars = GetIniBool(measure->userSettingsFile, measure->userSettingsChanged, L"Environment", L"FluentOverlayScrollBars", true); // Fluent Bars
-	bool trackingPrevention = GetIniBool(measure->userSettingsFile, measure->userSettingsChanged, L"Environment", L"TrackingPrevention", true);	// Tracking Prevention (SmartScreen)
-	bool extensions = GetIniBool(measure->userSettingsFile, measure->userSettingsChanged, L"Environment", L"Extensions", false); // Extensions
-	std::wstring language = GetIniString(measure->userSettingsFile, measure->userSettingsChanged, L"Environment", L"BrowserLocale", L"system"); // Language 
-	// Available browser flags: https://learn.microsoft.com/en-us/microsoft-edge/webview2/concepts/webview-features-flags?tabs=win32cpp#available-webview2-browser-flags
-	std::wstring userBrowserArgs = GetIniString(measure->userSettingsFile, measure->userSettingsChanged, L"Environment", L"BrowserArguments", L"--allow-file-access-from-files"); // Browser Flags
+	const UserSettings& userSettings = measure->userSettings->values;
+	bool fluentBars = userSettings.fluentOverlayScrollBars; // Fluent Bars
+	bool trackingPrevention = userSettings.trackingPrevention;	// Tracking Prevention (SmartScreen)
+	bool extensions = userSettings.extensions; // Extensions
+	const std::wstring& language = userSettings.browserLocale; // Language 
+	const std::wstring& userBrowserArgs = userSettings.browserArguments; // Browser Flags
 	std::wstring browserArgs;
 	browserArgs.append(L"--enable-features="); // Enable file access from file URLs
 	browserArgs.append(userBrowserArgs);
@@ -157,8 +157,8 @@ HRESULT Measure::CreateEnvironmentHandler(HRESULT result, ICoreWebView2Environme
 		CHECK_FAILURE(hr);
 
 		// Read options from UserSettings.ini
-		std::wstring scriptLocale = GetIniString(userSettingsFile, userSettingsChanged, L"Controller", L"ScriptLocale", L"system");
-		bool privateMode = GetIniBool(userSettingsFile, userSettingsChanged, L"Controller", L"PrivateMode", false);
+		const std::wstring& scriptLocale = userSettings->values.scriptLocale;
+		bool privateMode = userSettings->values.privateMode;
 
 		// OPTIONS
 		controllerOptions->put_ProfileName(L"rainmeter"); // Profile Name
@@ -210,13 +210,13 @@ void RegisterFrames(Measure* measure, ICoreWebView2Frame* rawFrame, int level)
 
 	// Add host object
 	wil::com_ptr<HostObjectRmAPI> hostObject =
-		Microsoft::WRL::Make<HostObjectRmAPI>(measure, g_typeLib);
+		Microsoft::WRL::Make<HostObjectRmAPI>(measure, GetTypeLib());
 
 	wil::unique_variant hostObjectVariant;
 	hostObject.query_to<IDispatch>(&hostObjectVariant.pdispVal);
 	hostObjectVariant.vt = VT_DISPATCH;
 
-	std::wstring origin = NormalizeUri(measure->currentUrl);
+	const std::wstring origin = measure->currentOrigin;
 	LPCWSTR origins = L"*"; // all-origins
 
 	CHECK_FAILURE(frame2->AddHostObjectToScriptWithOrigins(L"RainmeterAPI", &hostObjectVariant, 1, &origins));
@@ -386,10 +386,10 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 		webViewSettings->put_IsZoomControlEnabled(zoomControl);
 
 		// Read options from UserSettings.ini
-		bool statusBar = GetIniBool(userSettingsFile, userSettingsChanged, L"Core", L"StatusBar", true);
-		bool pinchZoom = GetIniBool(userSettingsFile, userSettingsChanged, L"Core", L"PinchZoom", true);
-		bool swipeNavigation = GetIniBool(userSettingsFile, userSettingsChanged, L"Core", L"SwipeNavigation", true);
-		bool reputationChecking = GetIniBool(userSettingsFile, userSettingsChanged, L"Core", L"SmartScreen", true);
+		bool statusBar = userSettings->values.statusBar;
+		bool pinchZoom = userSettings->values.pinchZoom;
+		bool swipeNavigation = userSettings->values.swipeNavigation;
+		bool reputationChecking = userSettings->values.smartScreen;
 
 		webViewSettings->put_IsStatusBarEnabled(statusBar);
 
@@ -437,10 +437,10 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 			CHECK_FAILURE(webView2_13->get_Profile(&profile));
 			
 			// Read options from UserSettings.ini
-			std::wstring downloadsFolder = GetIniString(userSettingsFile, userSettingsChanged, L"Profile", L"DownloadsFolderPath", L"");
-			std::wstring colorScheme = GetIniString(userSettingsFile, userSettingsChanged, L"Profile", L"ColorScheme", L"system");
-			bool passAutoSave = GetIniBool(userSettingsFile, userSettingsChanged, L"Profile", L"PasswordAutoSave", false);
-			bool generalAutoFill = GetIniBool(userSettingsFile, userSettingsChanged, L"Profile", L"GeneralAutoFill", true);
+			const std::wstring& downloadsFolder = userSettings->values.downloadsFolderPath;
+			const std::wstring& colorScheme = userSettings->values.colorScheme;
+			bool passAutoSave = userSettings->values.passwordAutoSave;
+			bool generalAutoFill = userSettings->values.generalAutoFill;
 
 			profile->put_DefaultDownloadFolderPath(downloadsFolder.c_str()); // Downloads folder path
 
@@ -484,9 +484,12 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 							}
 
 							// Load Extensions.ini
+							extensionsFile.Reset();
 							extensionsFile.SetUnicode();
 							extensionsFile.LoadFile(extensionsPath.c_str());
-							extensionsChanged = false;
+							extensionsFile.Freeze();
+
+							CSimpleIniW extensionsDefaults;
 
 							UINT extensionsCount = 0;
 							extensions->get_Count(&extensionsCount);
@@ -516,12 +519,10 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 												extension->get_Name(&name);
 
 												// Create the extension's section on Extensions.ini
-												extensionsFile.SetValue(folderName.c_str(), L"ID", id.get());
-												extensionsFile.SetValue(folderName.c_str(), L"Name", name.get());
-												extensionsFile.SetValue(folderName.c_str(), L"Enabled", L"true");
-												extensionsFile.SetValue(folderName.c_str(), L"Uninstall", L"false");
-												extensionsFile.SaveFile(extensionsPath.c_str());
-												extensionsChanged = false;
+												QueueIniValue(extensionsPath, folderName.c_str(), L"ID", id.get());
+												QueueIniValue(extensionsPath, folderName.c_str(), L"Name", name.get());
+												QueueIniValue(extensionsPath, folderName.c_str(), L"Enabled", L"true");
+												QueueIniValue(extensionsPath, folderName.c_str(), L"Uninstall", L"false");
 
 												extension->Enable(
 													TRUE,
@@ -577,8 +578,8 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 									extension->get_IsEnabled(&enabled);
 
 									// Read options from Extensions.ini
-									const bool enable = GetIniBool(extensionsFile, extensionsChanged, folderName.c_str(), L"Enabled", true);
-									const bool remove = GetIniBool(extensionsFile, extensionsChanged, folderName.c_str(), L"Uninstall", false);
+									const bool enable = GetIniBool(extensionsFile, extensionsDefaults, folderName.c_str(), L"Enabled", true);
+									const bool remove = GetIniBool(extensionsFile, extensionsDefaults, folderName.c_str(), L"Uninstall", false);
 
 									if (remove) // Uninstall Extension
 									{
@@ -592,9 +593,7 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 												}).Get());
 
 										// Delete section from Extensions.ini
-										extensionsFile.Delete(folderName.c_str(), nullptr);
-										extensionsFile.SaveFile(extensionsPath.c_str());
-										extensionsChanged = false;
+										QueueIniDeleteSection(extensionsPath, folderName.c_str());
 
 										RmLogF(rm, LOG_NOTICE, L"WebView2: \"%s\" extension removed.", name.get());
 										return S_OK;
@@ -622,11 +621,10 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 									addExtension(extensionPath, folderName);
 							}
 
-							if (extensionsChanged)
+							if (!extensionsDefaults.IsEmpty())
 							{
 								// Save Extensions.ini
-								extensionsFile.SaveFile(extensionsPath.c_str());
-								extensionsChanged = false;
+								QueueIniDefaults(extensionsPath, extensionsDefaults);
 							}
 
 							return S_OK;
@@ -636,7 +634,7 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 
 		// Create and inject COM Host Object for Rainmeter API
 		wil::com_ptr<HostObjectRmAPI> hostObject =
-			Microsoft::WRL::Make<HostObjectRmAPI>(this, g_typeLib);
+			Microsoft::WRL::Make<HostObjectRmAPI>(this, GetTypeLib());
 
 		VARIANT variant = {};
 		hostObject.query_to<IDispatch>(&variant.pdispVal);
@@ -689,12 +687,10 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 			Microsoft::WRL::Callback<ICoreWebView2NavigationStartingEventHandler>(
 				[this](ICoreWebView2* sender, ICoreWebView2NavigationStartingEventArgs* args) -> HRESULT
 				{
-					std::wstring nUri = NormalizeUri(currentUrl);
-
 					wil::com_ptr<ICoreWebView2NavigationStartingEventArgs2> navigationStartArgs;
 					if (SUCCEEDED(args->QueryInterface(IID_PPV_ARGS(&navigationStartArgs))))
 					{
-						navigationStartArgs->put_AdditionalAllowedFrameAncestors(nUri.c_str());
+						navigationStartArgs->put_AdditionalAllowedFrameAncestors(currentOrigin.c_str());
 					}
 					return S_OK;
 				}
@@ -724,7 +720,7 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 						wil::unique_cotaskmem_string documentTile;
 						webView->get_DocumentTitle(&documentTile);
 
-						bool isViewSource = documentTile && wcsncmp(documentTile.get(), L"view-source:", 12) == 0;
+						bool isViewSource = documentTile && ParseUrl(documentTile.get()).IsScheme(L"view-source");
 						
 						// Add Task Manager, Downloads and View Page Source items
 						wil::com_ptr<ICoreWebView2Environment9> webviewEnvironment9 = webViewEnvironment.try_query<ICoreWebView2Environment9>();
@@ -918,9 +914,9 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 					wil::unique_cotaskmem_string uri;
 					args->get_Uri(&uri);
 
-					bool isViewSource = uri && wcsncmp(uri.get(), L"view-source:", 12) == 0;
-					std::wstring viewSourceUrl = uri.get() + 12;
-					bool isVirtualHost = !viewSourceUrl.empty() && viewSourceUrl.find(hostName.c_str()) != std::wstring::npos;
+					const Url target = ParseUrl(uri ? uri.get() : L"");
+					bool isViewSource = target.IsScheme(L"view-source");
+					bool isVirtualHost = isViewSource && ParseUrl(target.SchemeSpecificPart()).IsHost(hostName);
 
 					// if url is view-source and contains hostname, open in same window:
 					if (isViewSource && isVirtualHost)
@@ -987,6 +983,8 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 			Callback<ICoreWebView2NavigationStartingEventHandler>(
 				[this](ICoreWebView2* sender, ICoreWebView2NavigationStartingEventArgs* args) -> HRESULT
 				{
+					RecordEvent(NavigationEventType::Start);
+
 					wil::unique_cotaskmem_string initialUri;
 					sender->get_Source(&initialUri);
 					wil::unique_cotaskmem_string destinationUri;
@@ -1005,11 +1003,7 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 
 					// Navigation is starting
 					SetStateAndNotify(100);
-					if (wcslen(onPageLoadStartAction.c_str()) > 0)
-					{
-						if (skin)
-							RmExecute(skin, onPageLoadStartAction.c_str());
-					}
+					NotifyAction(EVENT_PAGE_LOAD_START, onPageLoadStartAction);
 					return S_OK;
 				}
 			).Get(), nullptr
@@ -1020,19 +1014,16 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 			Callback<ICoreWebView2SourceChangedEventHandler>(
 				[this](ICoreWebView2* sender, ICoreWebView2SourceChangedEventArgs* args) -> HRESULT
 				{
+					RecordEvent(NavigationEventType::SourceChanged);
+
 					wil::unique_cotaskmem_string updatedUri;
 
 					if (SUCCEEDED(sender->get_Source(&updatedUri)) && updatedUri.get() != nullptr)
 					{
-						std::wstring newUrl = updatedUri.get();
-
-						if (currentUrl != newUrl)
+						if (currentUrl != updatedUri.get())
 						{
-							currentUrl = newUrl;
-							if (wcslen(onUrlChangeAction.c_str()) > 0)
-							{
-								if (skin) RmExecute(skin, onUrlChangeAction.c_str());
-							}
+							SetCurrentUrl(updatedUri.get());
+							NotifyAction(EVENT_URL_CHANGE, onUrlChangeAction);
 						}
 					}
 
@@ -1045,7 +1036,8 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 			Callback<ICoreWebView2DocumentTitleChangedEventHandler>(
 				[this](ICoreWebView2* sender, IUnknown* args) -> HRESULT
 				{
-					
+					RecordEvent(NavigationEventType::TitleChanged);
+
 					// Read current Url
 					wil::unique_cotaskmem_string uri;
 					sender->get_Source(&uri);
@@ -1055,27 +1047,20 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 					sender->get_DocumentTitle(&documentTile);
 					currentTitle = documentTile.get();
 
-					bool isViewSource = documentTile && wcsncmp(documentTile.get(), L"view-source:", 12) == 0;
+					bool isViewSource = documentTile && ParseUrl(documentTile.get()).IsScheme(L"view-source");
 					// Look for view-source on document title:
 					if (isViewSource)
 					{
-						currentUrl = documentTile.get();
-
-						if (wcslen(onUrlChangeAction.c_str()) > 0)
-						{
-							if (skin) RmExecute(skin, onUrlChangeAction.c_str());
-						}
+						SetCurrentUrl(documentTile.get());
+						NotifyAction(EVENT_URL_CHANGE, onUrlChangeAction);
 					}
 					else
 					{
 						// Look for view-source on current url and remove it:
-						if (wcsncmp(currentUrl.c_str(), L"view-source:", 12) == 0)
+						if (currentUrlParts.IsScheme(L"view-source"))
 						{
-							currentUrl = uri.get();
-							if (wcslen(onUrlChangeAction.c_str()) > 0)
-							{
-								if (skin) RmExecute(skin, onUrlChangeAction.c_str());
-							}
+							SetCurrentUrl(uri.get());
+							NotifyAction(EVENT_URL_CHANGE, onUrlChangeAction);
 						}
 					}
 
@@ -1091,13 +1076,9 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 				[this](ICoreWebView2* sender, ICoreWebView2ContentLoadingEventArgs* args) -> HRESULT
 				{
 					// Navigation is loading
+					RecordEvent(NavigationEventType::ContentLoading);
 					SetStateAndNotify(200);
-
-					if (wcslen(onPageLoadingAction.c_str()) > 0)
-					{
-						if (skin)
-							RmExecute(skin, onPageLoadingAction.c_str());
-					}
+					NotifyAction(EVENT_PAGE_LOADING, onPageLoadingAction);
 					return S_OK;
 				}
 			).Get(), nullptr
@@ -1112,13 +1093,9 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 					[this](ICoreWebView2* sender, ICoreWebView2DOMContentLoadedEventArgs* args) -> HRESULT
 					{
 						// DOM content is loaded
+						RecordEvent(NavigationEventType::DOMLoaded);
 						SetStateAndNotify(300);
-
-						if (wcslen(onPageDOMLoadAction.c_str()) > 0)
-						{
-							if (skin)
-								RmExecute(skin, onPageDOMLoadAction.c_str());
-						}
+						NotifyAction(EVENT_PAGE_DOM_LOAD, onPageDOMLoadAction);
 
 						return S_OK;
 					}
@@ -1132,6 +1109,17 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 				[this](ICoreWebView2* sender, ICoreWebView2NavigationCompletedEventArgs* args) -> HRESULT
 				{
 					// Navigation is complete
+					int httpStatus = 0;
+					COREWEBVIEW2_WEB_ERROR_STATUS errorStatus = COREWEBVIEW2_WEB_ERROR_STATUS_UNKNOWN;
+					args->get_WebErrorStatus(&errorStatus);
+
+					wil::com_ptr<ICoreWebView2NavigationCompletedEventArgs2> completedArgs2;
+					if (SUCCEEDED(args->QueryInterface(IID_PPV_ARGS(&completedArgs2))))
+					{
+						completedArgs2->get_HttpStatusCode(&httpStatus);
+					}
+
+					RecordEvent(NavigationEventType::Completed, httpStatus, static_cast<int>(errorStatus));
 					SetStateAndNotify(400);
 
 					// Call JavaScript OnInitialize callback if it exists and capture return value
@@ -1147,36 +1135,24 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 
 					if (isFirstLoad) // First load
 					{
-						if (wcslen(onPageFirstLoadAction.c_str()) > 0)
-						{
-							if (skin)
-								RmExecute(skin, onPageFirstLoadAction.c_str());
-						}
+						NotifyAction(EVENT_PAGE_FIRST_LOAD, onPageFirstLoadAction);
 						isFirstLoad = false;
 					}
 					else // Page reload
 					{
-						if (wcslen(onPageReloadAction.c_str()) > 0)
-						{
-							if (skin)
-								RmExecute(skin, onPageReloadAction.c_str());
-						}
+						NotifyAction(EVENT_PAGE_RELOAD, onPageReloadAction);
 					}
 					// Common action after any page load
-					if (wcslen(onPageLoadFinishAction.c_str()) > 0)
-					{
-						if (skin)
-							RmExecute(skin, onPageLoadFinishAction.c_str());
-					}
+					NotifyAction(EVENT_PAGE_LOAD_FINISH, onPageLoadFinishAction);
 					return S_OK;
 				}
 			).Get(), nullptr
 		);
 
-		if (userSettingsChanged)
+		// Write missing UserSettings.ini keys in one batch, profile keys only when the runtime has a profile
+		if (!userSettings->missingDefaults.IsEmpty())
 		{
-			userSettingsFile.SaveFile(configPath.c_str());
-			userSettingsChanged = false;
+			QueueIniDefaults(configPath, userSettings->missingDefaults, webView2_13 ? nullptr : L"Profile");
 		}
 
 		initialized = true;
@@ -1202,13 +1178,81 @@ HRESULT Measure::CreateControllerHandler(HRESULT result, ICoreWebView2Controller
 	return S_OK;
 }
 
+void Measure::SetCurrentUrl(const wchar_t* newUrl)
+{
+	currentUrl = newUrl ? newUrl : L"";
+
+	// Parsed and normalized once here instead of on every frame navigation
+	currentUrlParts = ParseUrl(currentUrl);
+	NormalizeUri(currentUrlParts, currentOrigin);
+}
+
 void Measure::SetStateAndNotify(int newState)
 {
 	state = newState;
+	NotifyAction(EVENT_STATE_CHANGE, onStateChangeAction);
+}
+
+void Measure::NotifyAction(unsigned int event, const std::wstring& action)
+{
+	if (coalesceActions)
+	{
+		// Delivered by FlushActions on the next Update
+		pendingEvents |= event;
+		return;
+	}
+
+	if (!action.empty() && skin)
+	{
+		RmExecute(skin, action.c_str());
+	}
+}
+
+void Measure::RecordEvent(NavigationEventType type, int httpStatus, int errorStatus)
+{
+	NavigationEvent& event = navigationEvents[navigationEventCount % navigationEvents.size()];
+	event.time = GetTickCount64();
+	event.type = type;
+	event.httpStatus = httpStatus;
+	event.errorStatus = errorStatus;
+	++navigationEventCount;
+}
 
-	if (!onStateChangeAction.empty() && skin)
+const std::wstring& Measure::GetEventAction(MeasureEvent event) const
+{
+	switch (event)
 	{
-		RmExecute(skin, onStateChangeAction.c_str());
+	case EVENT_STATE_CHANGE: return onStateChangeAction;
+	case EVENT_URL_CHANGE: return onUrlChangeAction;
+	case EVENT_PAGE_LOAD_START: return onPageLoadStartAction;
+	case EVENT_PAGE_LOADING: return onPageLoadingAction;
+	case EVENT_PAGE_DOM_LOAD: return onPageDOMLoadAction;
+	case EVENT_PAGE_FIRST_LOAD: return onPageFirstLoadAction;
+	case EVENT_PAGE_RELOAD: return onPageReloadAction;
+	case EVENT_PAGE_LOAD_FINISH: return onPageLoadFinishAction;
+	}
+
+	static const std::wstring s_none;
+	return s_none;
+}
+
+void Measure::FlushActions()
+{
+	if (pendingEvents == 0)
+		return;
+
+	deliveredEvents = pendingEvents;
+	pendingEvents = 0;
+
+	if (!skin)
+		return;
+
+	// Each action runs at most once, all of them as one bang
+	const std::wstring bang = BuildCoalescedBang(deliveredEvents,
+		[this](MeasureEvent event) -> const std::wstring& { return GetEventAction(event); });
+	if (!bang.empty())
+	{
+		RmExecute(skin, bang.c_str());
 	}
 }
 
@@ -1307,6 +1351,11 @@ void StopWebView2(Measure* measure)
 
 	// Clear url
 	measure->currentUrl.clear();
+	measure->currentUrlParts = Url();
+	measure->currentOrigin.clear();
+
+	// Registered scripts belonged to the released WebView
+	measure->scripts.clear();
 
 	// WebView is stopped
 	measure->SetStateAndNotify(-1);